@@ -0,0 +1,199 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+// Benchmark suite for the graph back end: generation, DFS and rendering
+// over a grid of sizes and edge probabilities with fixed seeds.
+//
+// Usage: lab7_bench [--n 500,2000] [--p 0.01,0.1,0.5] [--reps 3] [--filter name] [--json out.json]
+//
+
+#include "backend/graph_convert.h"
+#include "backend/graph_gen.h"
+#include "backend/graph_render.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+    constexpr std::uint64_t bench_seed = 0x5eed;
+
+    struct Options {
+        std::vector<int> sizes = {500, 2000, 5000};
+        std::vector<double> probs = {0.01, 0.1, 0.5};
+        int reps = 3;
+        std::string filter;
+        std::string json_path;
+    };
+
+    struct Result {
+        std::string name;
+        int n;
+        double p;
+        long long edges;
+        double best_ns;
+        double median_ns;
+        long peak_rss_kb;  // Peak resident set while the case ran, including what was resident before it
+    };
+
+    // Discards everything, keeps formatting cost without terminal I/O
+    class NullBuffer final : public std::streambuf {
+    protected:
+        int overflow(const int c) override { return c; }
+        std::streamsize xsputn(const char*, const std::streamsize count) override { return count; }
+    };
+
+    // Lower the peak resident set mark to the current RSS (Linux), so the next case reports its own peak
+    void reset_peak_rss() {
+        std::ofstream("/proc/self/clear_refs") << "5";
+    }
+
+    // VmHWM since the last reset; where /proc is missing, the process-wide (cumulative) peak
+    long peak_rss_kb() {
+        std::ifstream status("/proc/self/status");
+        for (std::string line; std::getline(status, line);) {
+            if (line.rfind("VmHWM:", 0) == 0) return std::stol(line.substr(6));
+        }
+#ifndef _WIN32
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+#else
+        return 0;
+#endif
+    }
+
+    template <typename T>
+    std::vector<T> parse_list(const std::string& text) {
+        std::vector<T> values;
+        std::stringstream ss(text);
+        std::string item;
+        while (std::getline(ss, item, ',')) {
+            if (item.empty()) continue;
+            if constexpr (std::is_same_v<T, int>) values.push_back(std::stoi(item));
+            else values.push_back(std::stod(item));
+        }
+        return values;
+    }
+
+    Options parse_options(const int argc, char** argv) {
+        Options options;
+        for (int i = 1; i + 1 < argc; i += 2) {
+            const std::string key = argv[i];
+            const std::string value = argv[i + 1];
+            if (key == "--n") options.sizes = parse_list<int>(value);
+            else if (key == "--p") options.probs = parse_list<double>(value);
+            else if (key == "--reps") options.reps = std::max(1, std::stoi(value));
+            else if (key == "--filter") options.filter = value;
+            else if (key == "--json") options.json_path = value;
+        }
+        return options;
+    }
+
+    class Runner {
+    public:
+        explicit Runner(const Options& opts) : options(opts) {}
+
+        void run(const std::string& name, const int n, const double p, const long long edges,
+                 const std::function<void()>& body) {
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+
+            std::vector<double> samples;
+            reset_peak_rss();
+            for (int rep = 0; rep < options.reps; rep++) {
+                const auto start = std::chrono::steady_clock::now();
+                body();
+                const auto stop = std::chrono::steady_clock::now();
+                samples.push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+            }
+            std::ranges::sort(samples);
+
+            const Result result{name, n, p, edges, samples.front(), samples[samples.size() / 2], peak_rss_kb()};
+            results.push_back(result);
+
+            const double per_edge = edges > 0 ? result.best_ns / static_cast<double>(edges) : 0.0;
+            std::printf("%-24s n=%-7d p=%-6g edges=%-10lld best=%10.3f ms  median=%10.3f ms  %8.2f ns/edge  rss=%ld KB\n",
+                        name.c_str(), n, p, edges, result.best_ns / 1e6, result.median_ns / 1e6, per_edge,
+                        result.peak_rss_kb);
+            std::fflush(stdout);
+        }
+
+        void write_json(const std::string& path) const {
+            std::ofstream file(path);
+            file << "{\n  \"seed\": " << bench_seed << ",\n  \"reps\": " << options.reps << ",\n  \"results\": [\n";
+            for (size_t i = 0; i < results.size(); i++) {
+                const auto& r = results[i];
+                const double per_edge = r.edges > 0 ? r.best_ns / static_cast<double>(r.edges) : 0.0;
+                file << "    {\"name\": \"" << r.name << "\", \"n\": " << r.n << ", \"p\": " << r.p
+                     << ", \"edges\": " << r.edges << ", \"best_ns\": " << r.best_ns
+                     << ", \"median_ns\": " << r.median_ns << ", \"ns_per_edge\": " << per_edge
+                     << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+            }
+            file << "  ]\n}\n";
+        }
+
+    private:
+        const Options& options;
+        std::vector<Result> results;
+    };
+}
+
+int main(const int argc, char** argv) {
+    const Options options = parse_options(argc, argv);
+    Runner runner(options);
+
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+
+    for (const int n : options.sizes) {
+        for (const double p : options.probs) {
+            Graph graph = create_graph_parallel(n, p, 0.1, bench_seed, 1, false);
+            ensure_matrix(graph);
+            ensure_list(graph);
+            // Undirected edges, loops counted once
+            const long long edges = graph_stats(graph).edges;
+
+            runner.run("create_graph", n, p, edges, [&] {
+                Graph g = create_graph(n, p, 0.1, static_cast<unsigned int>(bench_seed));
+            });
+            runner.run("create_graph_sparse", n, p, edges, [&] {
+                Graph g = create_graph_sparse(n, p, 0.1, bench_seed);
+            });
+            runner.run("create_graph_parallel", n, p, edges, [&] {
+                Graph g = create_graph_parallel(n, p, 0.1, bench_seed, 0, false);
+            });
+
+            Traversal result;
+            TraversalWorkspace workspace;
+            for (const bool recursive : {true, false}) {
+                const std::string suffix = recursive ? "_recursive" : "_iterative";
+                runner.run("prep" + suffix, n, p, edges, [&] { prep(graph, 0, recursive, result, workspace); });
+                runner.run("prep_list" + suffix, n, p, edges, [&] { prep_list(graph, 0, recursive, result, workspace); });
+                runner.run("prep_csr" + suffix, n, p, edges, [&] { prep_csr(graph, 0, recursive, result, workspace); });
+            }
+
+            runner.run("print_matrix", n, p, edges, [&] {
+                render_matrix(graph.adj_matrix, "Adjacency Matrix", {}, MatrixStyle::Table, null_stream);
+            });
+            runner.run("print_list", n, p, edges, [&] {
+                render_list(graph.adj_list, "Adjacency List", 0, -1, null_stream);
+            });
+        }
+    }
+
+    if (!options.json_path.empty()) {
+        runner.write_json(options.json_path);
+        std::printf("Results written to %s\n", options.json_path.c_str());
+    }
+    return 0;
+}
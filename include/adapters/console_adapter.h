@@ -5,7 +5,14 @@
 #ifndef CONSOLE_ADAPTER_H
 #define CONSOLE_ADAPTER_H
 
+#include <atomic>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
 
 #include "../core/console.h"
 #include "backend/graph_gen.h"
@@ -16,27 +23,73 @@ class GraphConsoleAdapter {
     ~GraphConsoleAdapter();
 
     void run();
+    // Report allocations per command from a counter the program keeps (see perf/time)
+    void count_allocations(const std::atomic<std::uint64_t>& counter);
+    // Non-interactive run of ';'-separated commands, returns the process exit status
+    int run_batch(const std::vector<std::string>& commands);
 
     private:
     Console console;
 
-    bool graphs_created;
-    std::unique_ptr<Graph> graph;
-    int n;
+    // Named graphs, clones share storage copy-on-write; commands work on the active one
+    std::map<std::string, std::unique_ptr<Graph>> graphs;
+    std::string active;
+    // Held by the command (foreground or job) working on that name; never erased, a waiting job may hold one
+    std::map<std::string, std::recursive_mutex> graph_locks;
+    mutable std::mutex registry_mutex;  // Guards the three above, never held while waiting for a graph lock
+
+    // Graph of the running command, bound per thread when it starts, so a job keeps its graph while the prompt moves on
+    inline static thread_local std::string bound;
+    inline static thread_local bool graphs_created = false;  // bound names an existing graph
+    inline static thread_local Graph* graph = nullptr;       // Owned by graphs
+    inline static thread_local int n = 0;
+
+    // Reused by every traversal command on the thread, keeps steady-state DFS allocation free
+    inline static thread_local TraversalWorkspace workspace;
+    inline static thread_local Traversal traversal;
 
     void cleanup();
+    // Registry: install replaces or adds name and makes it active, drop leaves no active graph if it was
+    void install(const std::string& name, std::unique_ptr<Graph> created);
+    bool activate(const std::string& name);
+    void drop(const std::string& name);
+    // --name, else the active graph, else "main"
+    std::string target_name(const std::unordered_map<std::string, std::string>& options) const;
+    // Console command guard: locks the graph a command works on and binds it on this thread
+    std::optional<std::unique_lock<std::recursive_mutex>> guard_command(const std::vector<std::string>& tokens, bool wait);
+    std::recursive_mutex& lock_of(const std::string& name);
+    void bind(const std::string& name);
+    void report_busy(const std::string& name) const;
     void register_graph_commands();
     std::string find_config_file(const std::string& filename, const std::vector<std::string>& search_paths);
     std::string get_default_config_path();
 
     void cmd_create(const std::vector<std::string>& args);
-    void cmd_print() const;
+    void cmd_print(const std::vector<std::string>& args = {}) const;
     void cmd_clear();
     void cmd_cleanup();
     void cmd_exit();
     void cmd_help(const std::vector<std::string>& args);
     void cmd_history();
     void cmd_traversal(const std::vector<std::string>& args) const;
+    void cmd_components(const std::vector<std::string>& args) const;
+    void cmd_bfs(const std::vector<std::string>& args) const;
+    void cmd_bfs_multi(const std::vector<std::string>& args) const;
+    void cmd_save(const std::vector<std::string>& args) const;
+    void cmd_load(const std::vector<std::string>& args);
+    void cmd_import(const std::vector<std::string>& args);
+    void cmd_stats(const std::vector<std::string>& args) const;
+    void cmd_add_edge(const std::vector<std::string>& args);
+    void cmd_remove_edge(const std::vector<std::string>& args);
+    void cmd_add_vertex();
+    void cmd_connected(const std::vector<std::string>& args);
+    void cmd_profile(const std::vector<std::string>& args);
+    void cmd_reorder(const std::vector<std::string>& args);
+    void cmd_metrics(const std::vector<std::string>& args) const;
+    void cmd_graphs();
+    void cmd_use(const std::vector<std::string>& args);
+    void cmd_clone(const std::vector<std::string>& args);
+    void cmd_drop(const std::vector<std::string>& args);
 };
 
 #endif //CONSOLE_ADAPTER_H
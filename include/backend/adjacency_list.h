@@ -0,0 +1,151 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef ADJACENCY_LIST_H
+#define ADJACENCY_LIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "arena.h"
+
+/**
+ * Adjacency list whose rows are carved from an arena instead of one heap vector per vertex.
+ * layout() places all rows back to back in a single block; a row that outgrows its
+ * capacity moves to a fresh arena slot of twice the size (amortized O(1) push_back),
+ * its old slot is simply abandoned until the arena is released.
+ * remove() leaves a tombstone in place of the entry; rows holding tombstones must be
+ * swept with compact() before they are read (ensure_list does it).
+ */
+class AdjacencyList {
+public:
+    static constexpr int tombstone = -1;
+
+    AdjacencyList() = default;
+
+    // n empty rows, storage comes from arena
+    AdjacencyList(const int n, std::shared_ptr<Arena> storage)
+        : rows(arena_array<Row>(storage, static_cast<std::size_t>(n))), arena(std::move(storage)),
+          count(static_cast<std::size_t>(n)), held(rows.bytes()) {}
+
+    /**
+     * Give row v room for capacity[v] entries, all rows in one contiguous block.
+     * Rows keep their current size, so call it on empty rows.
+     */
+    template <typename Capacities>
+    void layout(const Capacities& capacity) {
+        std::size_t total = 0;
+        for (std::size_t v = 0; v < count; v++) total += capacity[v];
+        int* block = total == 0 ? nullptr : static_cast<int*>(arena->allocate(total * sizeof(int)));
+        held += total * sizeof(int);
+        for (std::size_t v = 0; v < count; v++) {
+            rows[v] = {block, 0, static_cast<std::uint32_t>(capacity[v])};
+            block += capacity[v];
+        }
+    }
+
+    // Number of vertices
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    [[nodiscard]] std::span<const int> operator[](const int v) const { return {rows[v].data, rows[v].size}; }
+    [[nodiscard]] std::span<int> operator[](const int v) { return {rows[v].data, rows[v].size}; }
+
+    void push_back(const int v, const int value) {
+        Row& row = rows[v];
+        if (row.size == row.capacity && dead > 0) compact_row(row);
+        if (row.size == row.capacity) grow(row, std::max<std::uint32_t>(4, row.capacity * 2));
+        row.data[row.size++] = value;
+    }
+
+    // Append an empty row (amortized O(1), the row table doubles), returns its index
+    int add_row() {
+        if (count == rows.size()) {
+            SharedArray<Row> larger = arena_array<Row>(arena, std::max<std::size_t>(4, rows.size() * 2));
+            std::copy(rows.begin(), rows.end(), larger.begin());
+            held += larger.bytes() - rows.bytes();
+            rows = std::move(larger);
+        }
+        return static_cast<int>(count++);
+    }
+
+    // Replace the first live occurrence of value in row v with a tombstone, false if there is none
+    bool remove(const int v, const int value) {
+        const Row& row = rows[v];
+        int* found = std::find(row.data, row.data + row.size, value);
+        if (found == row.data + row.size) return false;
+        *found = tombstone;
+        if (dead++ == 0 || dirty.back() != v) dirty.push_back(v);
+        return true;
+    }
+
+    // Tombstones left by remove() and not yet swept
+    [[nodiscard]] std::size_t tombstones() const { return dead; }
+
+    // Sweep tombstones out of every row that has them, live entries keep their order
+    void compact() {
+        for (const int v : dirty) compact_row(rows[v]);
+        dirty.clear();
+        dead = 0;
+    }
+
+    // Replace row v with values
+    void assign(const int v, const std::span<const int> values) {
+        Row& row = rows[v];
+        if (values.size() > row.capacity) grow(row, static_cast<std::uint32_t>(values.size()));
+        std::ranges::copy(values, row.data);
+        row.size = static_cast<std::uint32_t>(values.size());
+    }
+
+    // Shrink row v to its first `keep` entries
+    void truncate(const int v, const std::size_t keep) {
+        rows[v].size = static_cast<std::uint32_t>(std::min<std::size_t>(keep, rows[v].size));
+    }
+
+    // Bytes held by the row table and the rows, abandoned slots not included
+    [[nodiscard]] std::size_t bytes() const { return held; }
+
+    // List over the same row table and rows, both must stay unmodified while shared; call compact() first
+    [[nodiscard]] AdjacencyList share() const {
+        AdjacencyList copy;
+        copy.rows = rows.share();
+        copy.arena = arena;
+        copy.count = count;
+        copy.held = held;
+        return copy;
+    }
+
+private:
+    struct Row {
+        int* data;
+        std::uint32_t size;
+        std::uint32_t capacity;
+    };
+
+    SharedArray<Row> rows;          // Row table, rows.size() is its capacity
+    std::shared_ptr<Arena> arena;
+    std::size_t count = 0;          // Rows in use
+    std::size_t held = 0;           // bytes()
+    std::size_t dead = 0;           // tombstones()
+    std::vector<int> dirty;         // Rows that got a tombstone since the last compact()
+
+    void grow(Row& row, const std::uint32_t capacity) {
+        auto* data = static_cast<int*>(arena->allocate(static_cast<std::size_t>(capacity) * sizeof(int)));
+        std::copy(row.data, row.data + row.size, data);
+        held += (static_cast<std::size_t>(capacity) - row.capacity) * sizeof(int);
+        row.data = data;
+        row.capacity = capacity;
+    }
+
+    void compact_row(Row& row) {
+        const auto kept = static_cast<std::uint32_t>(std::remove(row.data, row.data + row.size, tombstone) - row.data);
+        dead -= row.size - kept;
+        row.size = kept;
+    }
+};
+
+#endif //ADJACENCY_LIST_H
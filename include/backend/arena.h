@@ -0,0 +1,75 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "shared_array.h"
+
+struct ArenaOptions {
+    bool huge_pages = false;  // Ask for transparent huge pages on every block
+    bool populate = false;    // Pre-fault blocks when they are mapped (MAP_POPULATE)
+};
+
+/**
+ * Bump allocator over a few large mapped blocks. Memory is 64-byte aligned and
+ * zero-filled (fresh pages), nothing is freed individually: the blocks are
+ * unmapped together when the arena is destroyed. allocate() is thread-safe.
+ * reserve() lets a producer that knows its total size map everything at once.
+ */
+class Arena {
+public:
+    static constexpr std::size_t alignment = 64;
+    static constexpr std::size_t min_block_bytes = std::size_t{1} << 20;
+
+    explicit Arena(ArenaOptions options = {});
+    ~Arena();
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Make sure the next `bytes` of allocations fit in the current block
+    void reserve(std::size_t bytes);
+
+    // Zeroed, 64-byte aligned memory valid until the arena is destroyed
+    void* allocate(std::size_t bytes);
+
+    [[nodiscard]] const ArenaOptions& options() const { return config; }
+    [[nodiscard]] std::size_t mapped_bytes() const;
+    [[nodiscard]] std::size_t used_bytes() const;
+    [[nodiscard]] std::size_t block_count() const;
+
+private:
+    struct Block {
+        char* base;
+        std::size_t size;
+    };
+
+    ArenaOptions config;
+    mutable std::mutex mutex;
+    std::vector<Block> blocks;
+    char* cursor = nullptr;
+    char* limit = nullptr;
+    std::size_t used = 0;
+
+    void map_block(std::size_t bytes);
+};
+
+/**
+ * Zeroed array of count elements carved from arena; the array keeps the arena alive
+ * (aliasing shared_ptr), so every array of a graph shares one release
+ */
+template <typename T>
+SharedArray<T> arena_array(const std::shared_ptr<Arena>& arena, const std::size_t count) {
+    if (count == 0) return {};
+    auto* data = static_cast<T*>(arena->allocate(count * sizeof(T)));
+    return SharedArray<T>(data, count, std::shared_ptr<void>(arena, data));
+}
+
+#endif //ARENA_H
@@ -0,0 +1,71 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef BFS_H
+#define BFS_H
+
+#include <vector>
+
+#include "graph_gen.h"
+
+// Result of a breadth-first search, filled by BFS/BFS_list
+struct BFSResult {
+    std::vector<int> distance;     // Level of every vertex, -1 if unreachable
+    std::vector<int> parent;       // BFS tree parent, -1 for the source and unreachable vertices
+    std::vector<int> level_sizes;  // Vertices discovered per level, level_sizes[0] == 1
+    int top_down_steps = 0;
+    int bottom_up_steps = 0;
+    long long edges_checked = 0;   // Adjacency entries (or matrix words) inspected
+
+    // Clear for a graph of n vertices, keeps the allocated capacity
+    void reset(int n);
+};
+
+/**
+ * Direction-optimizing breadth-first search over the adjacency matrix.
+ * Switches between top-down steps (expand the frontier) and bottom-up steps
+ * (unvisited vertices look for any parent in the frontier bitmap), Beamer-style.
+ * Bottom-up on the matrix ANDs a row with the frontier a word at a time.
+ * @param v Source vertex
+ * @param graph Graph
+ * @param out Distances, parents and step statistics
+ * @param threads Worker threads (0 = all cores)
+ */
+extern void BFS(int v, const Graph& graph, BFSResult& out, int threads = 0);
+
+// Direction-optimizing breadth-first search over the adjacency list
+extern void BFS_list(int v, const Graph& graph, BFSResult& out, int threads = 0);
+
+// Maximum number of sources of one multi-source sweep (8 x 64-bit lanes per vertex)
+inline constexpr int max_multi_sources = 512;
+
+// Per-source result of a multi-source BFS
+struct MultiBFSResult {
+    std::vector<int> sources;
+    std::vector<long long> reached;       // Vertices reached per source (source included)
+    std::vector<int> eccentricity;        // Largest distance per source
+    std::vector<long long> distance_sum;  // Sum of distances to reached vertices per source
+    std::vector<int> distance;            // Source-major distances (sources x n), -1 unreachable; only if requested
+    int levels = 0;
+};
+
+/**
+ * Bit-parallel multi-source BFS (MS-BFS) over the adjacency list.
+ * Every vertex carries one bit per source packed into 64-bit lanes, one sweep
+ * over the lists advances all sources at once. Direction-optimizing like BFS:
+ * small frontiers push their lanes to their neighbours, large ones switch to a
+ * pull sweep where threads own disjoint vertex ranges without atomics.
+ * Sharing only pays while the sources' frontiers overlap; a long sweep whose
+ * lanes rarely meet (far apart sources on a grid) falls back to one BFS_list
+ * per source, with the same results.
+ * @param sources Up to max_multi_sources source vertices
+ * @param graph Graph
+ * @param out Per-source statistics
+ * @param threads Worker threads (0 = all cores)
+ * @param keep_distances Also fill out.distance (sources x n ints)
+ */
+extern void BFS_multi(const std::vector<int>& sources, const Graph& graph, MultiBFSResult& out, int threads = 0,
+                      bool keep_distances = false);
+
+#endif //BFS_H
@@ -0,0 +1,85 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef BIT_MATRIX_H
+#define BIT_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "shared_array.h"
+
+/**
+ * Square/rectangular 0/1 matrix packed one bit per cell.
+ * All rows live in a single 64-byte aligned allocation, every row is padded
+ * to a whole cache line so row(i) always starts on a line boundary.
+ * Padding bits past cols() are guaranteed to stay zero.
+ * Storage may also be adopted from a mapped snapshot file with the same layout.
+ */
+class BitMatrix {
+public:
+    using word_t = std::uint64_t;
+    static constexpr int word_bits = 64;
+    static constexpr std::size_t alignment = 64;
+
+    BitMatrix() = default;
+    BitMatrix(int rows, int cols);
+    // Adopt rows * padded_stride(cols) words laid out as above, throws on a size mismatch
+    BitMatrix(int rows, int cols, SharedArray<word_t> storage);
+    ~BitMatrix();
+
+    BitMatrix(const BitMatrix&) = delete;
+    BitMatrix& operator=(const BitMatrix&) = delete;
+    BitMatrix(BitMatrix&& other) noexcept;
+    BitMatrix& operator=(BitMatrix&& other) noexcept;
+
+    [[nodiscard]] bool test(const int r, const int c) const {
+        return (row(r)[c / word_bits] >> (c % word_bits)) & 1u;
+    }
+    void set(const int r, const int c) {
+        row(r)[c / word_bits] |= word_t{1} << (c % word_bits);
+    }
+    void reset(const int r, const int c) {
+        row(r)[c / word_bits] &= ~(word_t{1} << (c % word_bits));
+    }
+
+    [[nodiscard]] const word_t* row(const int r) const { return words.data() + static_cast<std::size_t>(r) * row_stride; }
+    [[nodiscard]] word_t* row(const int r) { return words.data() + static_cast<std::size_t>(r) * row_stride; }
+
+    [[nodiscard]] int rows() const { return n_rows; }
+    [[nodiscard]] int cols() const { return n_cols; }
+    // Words per row including cache line padding
+    [[nodiscard]] std::size_t stride() const { return row_stride; }
+    // Words actually covering cols() (without padding)
+    [[nodiscard]] std::size_t row_words() const { return words_for(n_cols); }
+    [[nodiscard]] std::size_t bytes() const { return static_cast<std::size_t>(n_rows) * row_stride * sizeof(word_t); }
+    [[nodiscard]] bool empty() const { return words.empty(); }
+
+    // Number of set bits in row r
+    [[nodiscard]] int row_count(int r) const;
+
+    // Free storage, matrix becomes empty
+    void release();
+
+    // Matrix over the same words, writes through either are seen by both
+    [[nodiscard]] BitMatrix share() const { return empty() ? BitMatrix() : BitMatrix(n_rows, n_cols, words.share()); }
+
+    static std::size_t words_for(const int bits) {
+        return (static_cast<std::size_t>(bits) + word_bits - 1) / word_bits;
+    }
+
+    // Row stride in words for cols columns, rounded up to a whole cache line
+    static std::size_t padded_stride(const int cols) {
+        constexpr std::size_t words_per_line = alignment / sizeof(word_t);
+        return (words_for(cols) + words_per_line - 1) / words_per_line * words_per_line;
+    }
+
+private:
+    SharedArray<word_t> words;
+    std::size_t row_stride = 0;
+    int n_rows = 0;
+    int n_cols = 0;
+};
+
+#endif //BIT_MATRIX_H
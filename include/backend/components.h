@@ -0,0 +1,34 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <vector>
+
+#include "graph_gen.h"
+
+struct Components {
+    std::vector<int> label;  // Component id per vertex, ids are ordered by smallest member vertex
+    std::vector<int> size;   // Vertex count per component id
+
+    [[nodiscard]] int count() const { return static_cast<int>(size.size()); }
+};
+
+/**
+ * Parallel connected components (Afforest: sampled neighbour rounds, then
+ * lock-free union-find over the remaining edges, skipping the giant component)
+ * @param graph Graph, adj_list is used
+ * @param threads Worker threads (0 = all cores)
+ * @return Component label per vertex and component sizes
+ */
+extern Components connected_components(const Graph& graph, int threads = 0);
+
+/**
+ * Component size histogram in power-of-two buckets
+ * @return histogram[k] = number of components with size in [2^k, 2^(k+1))
+ */
+extern std::vector<int> component_size_histogram(const Components& components);
+
+#endif //COMPONENTS_H
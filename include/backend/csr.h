@@ -0,0 +1,57 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef CSR_H
+#define CSR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "shared_array.h"
+
+/**
+ * Compressed sparse row adjacency: neighbours of v are
+ * neighbours[offsets[v] .. offsets[v + 1]), stored in one flat array.
+ * Both arrays may point into a mapped snapshot file (see snapshot.h).
+ * @tparam Offset Index type of the offsets array (32 or 64 bit)
+ */
+template <typename Offset>
+struct BasicCSR {
+    using offset_type = Offset;
+
+    SharedArray<Offset> offsets;   // n + 1 entries, offsets[0] == 0
+    SharedArray<int> neighbours;   // offsets[n] entries
+
+    [[nodiscard]] int vertices() const {
+        return offsets.empty() ? 0 : static_cast<int>(offsets.size() - 1);
+    }
+    [[nodiscard]] std::size_t entries() const { return neighbours.size(); }
+    [[nodiscard]] int degree(const int v) const {
+        return static_cast<int>(offsets[v + 1] - offsets[v]);
+    }
+    [[nodiscard]] std::span<const int> operator[](const int v) const {
+        return {neighbours.data() + offsets[v], static_cast<std::size_t>(offsets[v + 1] - offsets[v])};
+    }
+    [[nodiscard]] std::size_t bytes() const {
+        return offsets.size() * sizeof(Offset) + neighbours.size() * sizeof(int);
+    }
+    [[nodiscard]] BasicCSR share() const { return {offsets.share(), neighbours.share()}; }
+    void clear() {
+        offsets.clear();
+        neighbours.clear();
+    }
+};
+
+using CSR32 = BasicCSR<std::uint32_t>;
+using CSR64 = BasicCSR<std::uint64_t>;
+
+// 32-bit offsets halve the index array; enable CSR_64BIT_OFFSETS for graphs above 4G entries
+#ifdef LAB7_CSR_64BIT_OFFSETS
+using CSR = CSR64;
+#else
+using CSR = CSR32;
+#endif
+
+#endif //CSR_H
@@ -0,0 +1,38 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef EDGE_IMPORT_H
+#define EDGE_IMPORT_H
+
+#include <cstddef>
+#include <string>
+
+#include "graph_gen.h"
+
+// Bytes read per chunk, one chunk is parsed while the next one is being read
+inline constexpr std::size_t import_chunk_bytes = std::size_t{64} << 20;
+
+struct ImportStats {
+    std::size_t bytes = 0;       // File size
+    std::size_t edges = 0;       // Edge lines parsed
+    std::size_t duplicates = 0;  // Repeated edges dropped (including "v u" after "u v")
+    std::size_t loops = 0;       // Distinct self-loops kept
+};
+
+/**
+ * Import an undirected graph from a text edge list: one "u v" pair of non-negative
+ * vertex ids per line, anything after the pair is ignored, lines starting with
+ * '#' or '%' and blank lines are skipped. n is the largest id + 1.
+ * Chunks are parsed in parallel without iostreams, lists are built by a parallel
+ * counting sort by source into the CSR and come out sorted and deduplicated.
+ * Throws std::runtime_error on I/O errors and malformed lines.
+ * @param path Edge list file
+ * @param stats Filled with import statistics
+ * @param threads Worker threads (0 = all cores)
+ * @param arena Storage options of the new graph
+ * @return New Graph, only csr is built
+ */
+extern Graph import_edge_list(const std::string& path, ImportStats& stats, int threads = 0, ArenaOptions arena = {});
+
+#endif //EDGE_IMPORT_H
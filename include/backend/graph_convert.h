@@ -0,0 +1,44 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef GRAPH_CONVERT_H
+#define GRAPH_CONVERT_H
+
+#include <cstddef>
+
+#include "graph_gen.h"
+
+/**
+ * Materialize the adjacency matrix if it is not built yet (parallel, from the CSR or adj_list).
+ * Throws std::length_error when graph.n > max_matrix_vertices.
+ * @param graph Graph
+ * @param threads Worker threads (0 = all cores)
+ * @return graph.adj_matrix
+ */
+extern const BitMatrix& ensure_matrix(Graph& graph, int threads = 0);
+
+// Materialize adj_list if it is not built yet (parallel, from the CSR or the matrix),
+// sweeps tombstones left by remove_edge out of an existing one
+extern const AdjacencyList& ensure_list(Graph& graph, int threads = 0);
+
+// Materialize the CSR if it is not built yet (parallel, from adj_list or the matrix)
+extern const CSR& ensure_csr(Graph& graph, int threads = 0);
+
+// Sizes and counts of a graph, see graph_stats
+struct GraphStats {
+    int vertices = 0;
+    long long edges = 0;        // Undirected edges, self-loops included
+    long long self_loops = 0;
+    std::size_t matrix_bytes = 0;  // 0 for representations that are not built
+    std::size_t list_bytes = 0;
+    std::size_t csr_bytes = 0;
+};
+
+/**
+ * Count edges and self-loops (from whichever representation is built, in parallel)
+ * and report the memory held by every representation
+ */
+extern GraphStats graph_stats(const Graph& graph, int threads = 0);
+
+#endif //GRAPH_CONVERT_H
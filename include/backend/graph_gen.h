@@ -5,57 +5,271 @@
 #ifndef GRAPH_GEN_H
 #define GRAPH_GEN_H
 
+#include <cstdint>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <vector>
 
+#include "adjacency_list.h"
+#include "arena.h"
+#include "bit_matrix.h"
+#include "csr.h"
+#include "union_find.h"
+#include "visited_set.h"
+
+// Wall time in milliseconds spent building the graph and each representation
+struct BuildTimes {
+    double generate = 0;  // Generator, importer or snapshot load, including the representation it produced
+    double matrix = 0;    // Conversions done on first use (graph_convert.h)
+    double list = 0;
+    double csr = 0;
+};
+
+/**
+ * Map between the stored vertex ids of a relabeled graph (see reorder.h) and the ids
+ * it was created with. Empty while the two are the same.
+ */
+struct VertexIds {
+    std::vector<int> original;  // original[v] = id vertex v was created with
+    std::vector<int> current;   // current[o] = stored id of original vertex o
+
+    [[nodiscard]] bool identity() const { return original.empty(); }
+    [[nodiscard]] int to_original(const int v) const { return identity() ? v : original[v]; }
+
+    // Ids outside the graph are passed through, so callers still report them as out of range
+    [[nodiscard]] int to_current(const int o) const {
+        return identity() || o < 0 || o >= static_cast<int>(current.size()) ? o : current[o];
+    }
+
+    // Map stored ids to original ids in place
+    void restore(std::vector<int>& vertices) const {
+        if (identity()) return;
+        for (int& v : vertices) v = original[v];
+    }
+
+    // Vertex v appended to a graph of v vertices keeps its id in both numberings
+    void append(const int v) {
+        if (identity()) return;
+        original.push_back(v);
+        current.push_back(v);
+    }
+};
+
+/**
+ * Graph in up to three representations. A generator fills one of them (create_graph
+ * the matrix, everything else the CSR), the others stay empty until they are
+ * materialized on first use by ensure_matrix/ensure_list/ensure_csr (graph_convert.h).
+ * All storage is carved from the graph's arena, so destroying or resetting a graph
+ * is a single release. Move-only; clone_graph (graph_update.h) shares the storage
+ * copy-on-write. In-place updates are in graph_update.h, relabeling for locality in
+ * reorder.h.
+ */
 struct Graph {
-    int** adj_matrix;
-    std::vector<std::vector<int>> adj_list;
-    int n;
+    std::shared_ptr<Arena> arena;
+    BitMatrix adj_matrix;
+    AdjacencyList adj_list;
+    CSR csr;
+    int n = 0;
+    BuildTimes build_ms;
+    UnionFind connectivity;  // Built by the first connected() query, empty while stale
+    VertexIds ids;           // Original ids after a reorder
+    // Held by every clone over the same representations, the first update of a shared graph copies them
+    std::shared_ptr<const char> storage = std::make_shared<const char>();
+
+    explicit Graph(const int vertices = 0, const ArenaOptions options = {})
+        : arena(std::make_shared<Arena>(options)), n(vertices) {}
+
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+    Graph(Graph&&) noexcept = default;
+    Graph& operator=(Graph&&) noexcept = default;
+
+    [[nodiscard]] bool has_matrix() const { return !adj_matrix.empty(); }
+    [[nodiscard]] bool has_list() const { return !adj_list.empty(); }
+    [[nodiscard]] bool has_csr() const { return !csr.offsets.empty(); }
+    // Other graphs reading the same representations
+    [[nodiscard]] long sharers() const { return storage.use_count() - 1; }
+
+    // Zeroed array from the graph's arena
+    template <typename T>
+    SharedArray<T> allocate(const std::size_t count) { return arena_array<T>(arena, count); }
+
+    // Empty n x n matrix backed by the arena
+    BitMatrix allocate_matrix() {
+        return {n, n, allocate<BitMatrix::word_t>(static_cast<std::size_t>(n) * BitMatrix::padded_stride(n))};
+    }
 };
 
+// The adjacency matrix is never materialized above this many vertices (2 GiB of bits)
+inline constexpr int max_matrix_vertices = 1 << 17;
+
 /**
  * Function for allocating memory for a graph with edge generating probabilities
  * @param n Graph size
  * @param edgeProb Edge generating probability
  * @param loopProb Loop edge generating probability
  * @param seed Seed for random generator
- * @return New Graph
+ * @param arena Storage options of the new graph
+ * @return New Graph, only adj_matrix is built
+ */
+extern Graph create_graph(int n, double edgeProb = 0.4, double loopProb = 0.15, unsigned int seed = 0,
+                          ArenaOptions arena = {});
+
+/**
+ * Sparse graph generator (Batagelj-Brandes geometric edge skipping).
+ * Draws the gap to the next edge instead of testing every pair, so the cost is O(n + m).
+ * Same G(n, p) distribution as create_graph, with exact double probabilities.
+ * @param n Graph size
+ * @param edgeProb Edge generating probability
+ * @param loopProb Loop edge generating probability
+ * @param seed Seed for random generator (0 = time based)
+ * @param arena Storage options of the new graph
+ * @return New Graph, only csr is built
+ */
+extern Graph create_graph_sparse(int n, double edgeProb, double loopProb, std::uint64_t seed = 0,
+                                 ArenaOptions arena = {});
+
+/**
+ * Parallel, seed-reproducible graph generator.
+ * Every row draws from its own Philox stream keyed by (seed, row), so threads fill
+ * blocks of rows independently and the result is bit-identical for any thread count.
+ * @param n Graph size
+ * @param edgeProb Edge generating probability
+ * @param loopProb Loop edge generating probability
+ * @param seed Seed for random generator (used as is, see time_seed)
+ * @param threads Worker threads (0 = all cores)
+ * @param sparse Geometric edge skipping inside rows instead of testing every pair
+ * @param arena Storage options of the new graph
+ * @return New Graph, only csr is built
+ */
+extern Graph create_graph_parallel(int n, double edgeProb, double loopProb, std::uint64_t seed,
+                                   int threads = 0, bool sparse = false, ArenaOptions arena = {});
+
+// Structured and skewed models. Like create_graph_parallel they are parallel and
+// reproducible for a fixed seed on any thread count, and only build the CSR.
+// Self-loops and duplicate edges are dropped, neighbour rows come out sorted.
+
+/**
+ * R-MAT (Kronecker) generator with the Graph500 quadrant probabilities
+ * (0.57, 0.19, 0.19, 0.05): power-law degrees with hubs at the low ids
+ * @param n Graph size
+ * @param degree Average degree (n * degree / 2 edges are drawn)
+ * @param seed Seed for random generator (used as is, see time_seed)
+ * @param threads Worker threads (0 = all cores)
+ * @param arena Storage options of the new graph
  */
-extern Graph create_graph(int n, double edgeProb = 0.4, double loopProb = 0.15, unsigned int seed = 0);
+extern Graph create_graph_rmat(int n, double degree, std::uint64_t seed, int threads = 0, ArenaOptions arena = {});
+
+/**
+ * Barabasi-Albert preferential attachment: every vertex links to `attach` earlier vertices
+ * picked proportionally to their degree. Edge targets are resolved independently by
+ * following earlier edge slots (Sanders-Schulz), so vertices are generated in parallel.
+ * @param n Graph size
+ * @param attach Edges per new vertex
+ * @param seed Seed for random generator (used as is, see time_seed)
+ * @param threads Worker threads (0 = all cores)
+ * @param arena Storage options of the new graph
+ */
+extern Graph create_graph_ba(int n, int attach, std::uint64_t seed, int threads = 0, ArenaOptions arena = {});
+
+/**
+ * 2D or 3D grid with n vertices in row-major order on the smallest square (cube)
+ * that holds them, the last row and layer may be partial
+ * @param n Graph size
+ * @param dimensions 2 or 3
+ * @param threads Worker threads (0 = all cores)
+ * @param arena Storage options of the new graph
+ */
+extern Graph create_graph_grid(int n, int dimensions, int threads = 0, ArenaOptions arena = {});
+
+/**
+ * Random geometric graph: n uniform points in the unit square, an edge between
+ * every pair closer than radius (found through a grid of radius-wide cells)
+ * @param n Graph size
+ * @param radius Connection radius
+ * @param seed Seed for random generator (used as is, see time_seed)
+ * @param threads Worker threads (0 = all cores)
+ * @param arena Storage options of the new graph
+ */
+extern Graph create_graph_geometric(int n, double radius, std::uint64_t seed, int threads = 0,
+                                    ArenaOptions arena = {});
+
+// Seed derived from the clock, distinct for back-to-back calls
+extern std::uint64_t time_seed();
 
 // Function to display the matrix
-extern void print_matrix(int **matrix, int rows, int cols, const char *name);
+extern void print_matrix(const BitMatrix& matrix, const char *name);
 
-// Free matrix memory
-extern void delete_graph(Graph& graph, int n);
+// Release all graph memory at once (drops the arena), graph becomes empty
+extern void delete_graph(Graph& graph);
 
 // Display adj list
-extern void print_list(const std::vector<std::vector<int>> &list, const char *name);
+extern void print_list(const AdjacencyList &list, const char *name);
+
+// Result of a traversal, filled by DFS/prep without any I/O
+struct Traversal {
+    std::vector<int> order;   // Vertices in visitation order
+    std::vector<int> parent;  // DFS tree parent of every vertex in order, -1 for roots
+
+    // Clear for a graph of n vertices, keeps the allocated capacity (parent is not cleared)
+    void reset(int n);
+};
+
+/**
+ * Scratch state reused across traversals of one graph: epoch-stamped visited set
+ * (O(1) reset) and a vector-backed stack that keeps its capacity, so steady-state
+ * traversals do not allocate.
+ */
+struct TraversalWorkspace {
+    VisitedSet visited;
+    std::vector<std::pair<int, int>> stack;  // Iterative DFS frames: (vertex, next neighbour cursor)
+};
 
 /**
  * Depth-first search algorithm
  * @param v Vertex
  * @param graph Graph
- * @param visited Array of visited vertices
+ * @param workspace Visited set (prepared for graph.n) and stack
  * @param is_recursive Method of traversal (recursive or iterative)
+ * @param out Visit order and parents are appended here (parent sized to graph.n)
  */
-extern void DFS(int v, const Graph& graph, bool* visited, bool is_recursive);
+extern void DFS(int v, const Graph& graph, TraversalWorkspace& workspace, bool is_recursive, Traversal& out);
 
-// Preparation algorithm for DFS
-extern void prep(const Graph& graph, int vert, bool is_recursive);
+/**
+ * Preparation algorithm for DFS, resets out and the workspace and fills out. The recursive
+ * variant restarts from every unvisited vertex whose original id (graph.ids) is at least
+ * that of vert, so the vertices reached do not change after a reorder.
+ */
+extern void prep(const Graph& graph, int vert, bool is_recursive, Traversal& out, TraversalWorkspace& workspace);
 
 // Preparation algorithm for DFS (list representation)
-extern void prep_list(const Graph& graph, int vert, bool is_recursive);
+extern void prep_list(const Graph& graph, int vert, bool is_recursive, Traversal& out, TraversalWorkspace& workspace);
 
 /**
  * Depth-first search algorithm for adjacency list
  * @param v Vertex
  * @param graph Graph
- * @param visited Array of visited vertices
+ * @param workspace Visited set (prepared for graph.n) and stack
  * @param is_recursive Method of traversal (recursive or iterative)
+ * @param out Visit order and parents are appended here (parent sized to graph.n)
  */
-extern void DFS_list(int v, const Graph& graph, bool* visited, bool is_recursive);
-#endif //GRAPH_GEN_H
+extern void DFS_list(int v, const Graph& graph, TraversalWorkspace& workspace, bool is_recursive, Traversal& out);
+
+/**
+ * Depth-first search algorithm for CSR representation
+ * @param v Vertex
+ * @param graph Graph
+ * @param workspace Visited set (prepared for graph.n) and stack
+ * @param is_recursive Method of traversal (recursive or iterative)
+ * @param out Visit order and parents are appended here (parent sized to graph.n)
+ */
+extern void DFS_csr(int v, const Graph& graph, TraversalWorkspace& workspace, bool is_recursive, Traversal& out);
+
+// Preparation algorithm for DFS (CSR representation)
+extern void prep_csr(const Graph& graph, int vert, bool is_recursive, Traversal& out, TraversalWorkspace& workspace);
+
+// Display visit order on one line
+extern void print_traversal(const Traversal& traversal);
+#endif //GRAPH_GEN_H
\ No newline at end of file
@@ -0,0 +1,86 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef GRAPH_RENDER_H
+#define GRAPH_RENDER_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "adjacency_list.h"
+#include "bit_matrix.h"
+#include "csr.h"
+
+/**
+ * Text buffer that is written to the stream in large chunks.
+ * Formatting goes into a preallocated string, the stream sees one write() per chunk.
+ */
+class OutputBuffer {
+public:
+    explicit OutputBuffer(std::ostream& os, std::size_t chunk = std::size_t{1} << 20);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void put(const char c) {
+        buffer.push_back(c);
+        if (buffer.size() >= chunk_size) flush();
+    }
+    void put(std::string_view text);
+    void put_repeat(char c, std::size_t count);
+    // Right aligned integer padded to width
+    void put_int(long long value, int width = 0);
+    void flush();
+
+private:
+    std::ostream& out;
+    std::string buffer;
+    std::size_t chunk_size;
+};
+
+// Half-open rows/cols range to render, end < 0 means "up to the last one"
+struct RenderWindow {
+    int row_begin = 0;
+    int row_end = -1;
+    int col_begin = 0;
+    int col_end = -1;
+};
+
+enum class MatrixStyle {
+    Table,  // Bordered table with row and column indices
+    Bits    // One character per cell, rows prefixed with their index
+};
+
+/**
+ * Render (a window of) a bit matrix
+ * @param matrix Matrix
+ * @param name Title line
+ * @param window Rows/cols to render, clamped to the matrix
+ * @param style Table or compact bit characters
+ * @param os Output stream
+ */
+extern void render_matrix(const BitMatrix& matrix, const char* name, const RenderWindow& window = {},
+                          MatrixStyle style = MatrixStyle::Table, std::ostream& os = std::cout);
+
+// Render adjacency list rows [begin, end), end < 0 means up to the last vertex
+extern void render_list(const AdjacencyList& list, const char* name, int begin = 0, int end = -1,
+                        std::ostream& os = std::cout);
+extern void render_list(const CSR& csr, const char* name, int begin = 0, int end = -1,
+                        std::ostream& os = std::cout);
+
+/**
+ * Export a downsampled density map of the adjacency structure.
+ * Vertices are bucketed into a size x size grid, format follows the extension:
+ * .pgm - grayscale, darker cells hold more edges; .pbm - black where any edge exists.
+ * @param csr Graph adjacency
+ * @param path Output file (.pgm or .pbm)
+ * @param size Image side in pixels, clamped to the vertex count
+ * @return true on success
+ */
+extern bool export_density_map(const CSR& csr, const std::string& path, int size = 512);
+
+#endif //GRAPH_RENDER_H
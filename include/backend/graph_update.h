@@ -0,0 +1,53 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef GRAPH_UPDATE_H
+#define GRAPH_UPDATE_H
+
+#include "graph_gen.h"
+
+/**
+ * In-place updates. adj_list is the mutable representation (converted once on the
+ * first update), adj_matrix is patched alongside it when built; the CSR is immutable
+ * and is dropped, ensure_csr rebuilds it on next use. When abandoned arena slots
+ * outweigh the live storage the graph is copied into a fresh arena, as is a graph
+ * that still shares its storage with a clone before its first update.
+ */
+
+/**
+ * Copy-on-write copy: the clone reads the same matrix, list and CSR storage (and arena)
+ * until either graph is updated, O(n) only for the connectivity and id maps.
+ * Representations materialized later belong to the graph that built them.
+ * @param graph Source, its list tombstones are swept first
+ */
+extern Graph clone_graph(Graph& graph);
+
+/**
+ * Add undirected edge u-v (u == v adds a self-loop), amortized O(1) plus a duplicate
+ * check (matrix bit, or a scan of the shorter row)
+ * @return false if the edge already exists
+ */
+extern bool add_edge(Graph& graph, int u, int v, int threads = 0);
+
+/**
+ * Remove undirected edge u-v, the list entries become tombstones swept on the next read
+ * @return false if there is no such edge
+ */
+extern bool remove_edge(Graph& graph, int u, int v, int threads = 0);
+
+/**
+ * Append an isolated vertex; the matrix cannot grow in place and is dropped
+ * (ensure_matrix rebuilds it on next use)
+ * @return Id of the new vertex (the old graph.n)
+ */
+extern int add_vertex(Graph& graph, int threads = 0);
+
+/**
+ * Whether u and v are in one component. Insertions are merged into graph.connectivity
+ * incrementally; a deletion marks it stale and the next query rebuilds it once from
+ * connected_components, so a batch of deletions costs a single recompute.
+ */
+extern bool connected(Graph& graph, int u, int v, int threads = 0);
+
+#endif //GRAPH_UPDATE_H
@@ -0,0 +1,51 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <vector>
+
+#include "graph_gen.h"
+
+// How triangles are counted, see graph_metrics
+enum class TriangleMethod {
+    Auto,    // Bitset when the matrix is built or the graph is dense enough to build it, merge otherwise
+    Bitset,  // Popcount of AND-ed matrix rows
+    Merge    // Sorted-list merge over degree-ordered out-neighbours
+};
+
+// Degree statistics and triangle count of a graph, degrees do not count self-loops
+struct GraphMetrics {
+    int vertices = 0;
+    long long edges = 0;          // Undirected edges, self-loops included
+    long long self_loops = 0;
+    int max_degree = 0;
+    double average_degree = 0;
+    int isolated = 0;             // Vertices of degree 0
+    std::vector<int> degree_histogram;  // degree_histogram[k] = vertices with degree in [2^k, 2^(k+1))
+    long long triangles = 0;
+    long long wedges = 0;         // Paths of length two, sum of d * (d - 1) / 2
+    bool bitset = false;          // Triangles were counted on the matrix
+    double triangle_ms = 0;
+
+    // Global clustering coefficient (transitivity): 3 * triangles / wedges
+    [[nodiscard]] double clustering() const {
+        return wedges == 0 ? 0.0 : 3.0 * static_cast<double>(triangles) / static_cast<double>(wedges);
+    }
+};
+
+/**
+ * Degree histogram, max/average degree, self-loops and the exact triangle count,
+ * parallel across vertices. Triangles are counted once each: on the matrix every
+ * edge u < v adds popcount(row u & row v) over the columns above v, otherwise edges
+ * are oriented from lower to higher (degree, id) and the sorted out-neighbour lists
+ * of both endpoints are merged, which bounds every list by O(sqrt(m)).
+ * @param graph Graph, the representation used is materialized on demand
+ * @param threads Worker threads (0 = all cores)
+ * @param method Triangle counting method
+ */
+extern GraphMetrics graph_metrics(Graph& graph, int threads = 0, TriangleMethod method = TriangleMethod::Auto);
+
+#endif //METRICS_H
@@ -0,0 +1,159 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../core/cancellation.h"
+
+// Number of worker threads to use, 0 or negative means all hardware threads
+inline int resolve_threads(const int threads) {
+    if (threads > 0) return threads;
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw == 0 ? 1 : static_cast<int>(hw);
+}
+
+/**
+ * Threads kept alive between parallel_for calls, so per-level loops (BFS, label propagation)
+ * do not pay a thread spawn and join per level. One parallel_for owns the pool at a time;
+ * a concurrent or nested call falls back to threads of its own.
+ */
+class WorkerPool {
+public:
+    static WorkerPool& instance() {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& thread : threads) thread.join();
+    }
+
+    /**
+     * Run task(id) for id in [1, workers) on pool threads while the caller runs task(0).
+     * @return False without running anything when the pool is already in use
+     */
+    template <typename Task>
+    bool try_run(const int workers, const Task& task) {
+        if (busy.exchange(true, std::memory_order_acquire)) return false;
+        {
+            std::lock_guard lock(mutex);
+            while (static_cast<int>(threads.size()) < workers - 1) {
+                threads.emplace_back(&WorkerPool::loop, this, static_cast<int>(threads.size()) + 1);
+            }
+            context = &task;
+            body = [](const void* ctx, const int id) { (*static_cast<const Task*>(ctx))(id); };
+            helpers = workers - 1;
+            pending = workers - 1;
+            generation++;
+        }
+        wake.notify_all();
+
+        std::exception_ptr error;
+        try {
+            task(0);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            // Helpers reference the caller's stack, so wait for them even when task(0) threw
+            std::unique_lock lock(mutex);
+            done.wait(lock, [&] { return pending == 0; });
+        }
+        busy.store(false, std::memory_order_release);
+        if (error) std::rethrow_exception(error);
+        return true;
+    }
+
+private:
+    WorkerPool() = default;
+
+    void loop(const int id) {
+        std::uint64_t seen = 0;
+        std::unique_lock lock(mutex);
+        for (;;) {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            if (id > helpers) continue;
+            const void* ctx = context;
+            void (*run)(const void*, int) = body;
+            lock.unlock();
+            run(ctx, id);
+            lock.lock();
+            if (--pending == 0) done.notify_one();
+        }
+    }
+
+    std::atomic<bool> busy{false};
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::vector<std::thread> threads;
+    const void* context = nullptr;
+    void (*body)(const void*, int) = nullptr;
+    std::uint64_t generation = 0;
+    int helpers = 0;
+    int pending = 0;
+    bool stopping = false;
+};
+
+/**
+ * Run fn(begin, end, thread_id) over [0, count) in chunks of `grain` items.
+ * Chunks are handed out dynamically, so uneven work (e.g. triangular rows) stays balanced.
+ * Runs inline on the calling thread when only one thread is requested or the range fits
+ * in a single chunk; otherwise the chunks go to the shared WorkerPool.
+ * @param count Number of items
+ * @param threads Thread count (see resolve_threads)
+ * @param fn Chunk body
+ * @param grain Items per chunk (0 = automatic)
+ */
+template <typename Fn>
+void parallel_for(const std::size_t count, const int threads, Fn&& fn, std::size_t grain = 0) {
+    if (count == 0) return;
+    const std::size_t chunks = grain == 0 ? count : (count + grain - 1) / grain;
+    const int workers = static_cast<int>(std::min<std::size_t>(resolve_threads(threads), chunks));
+    if (workers <= 1) {
+        fn(std::size_t{0}, count, 0);
+        return;
+    }
+    if (grain == 0) grain = std::max<std::size_t>(1, count / (static_cast<std::size_t>(workers) * 16));
+
+    std::atomic<std::size_t> next{0};
+    JobControl* const job = current_job;
+    const auto worker = [&](const int id) {
+        current_job = job;  // Bodies poll the caller's job (cancel_requested)
+        for (std::size_t begin = next.fetch_add(grain); begin < count; begin = next.fetch_add(grain)) {
+            fn(begin, std::min(count, begin + grain), id);
+        }
+    };
+
+    if (WorkerPool::instance().try_run(workers, worker)) return;
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (int id = 1; id < workers; id++) pool.emplace_back(worker, id);
+    worker(0);
+    for (auto& thread : pool) thread.join();
+}
+
+#endif //PARALLEL_H
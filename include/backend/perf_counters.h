@@ -0,0 +1,74 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+enum class HwEvent {
+    Cycles,
+    Instructions,
+    L1dMisses,     // L1 data cache read misses
+    LlcMisses,     // Last level cache misses
+    BranchMisses,
+    DtlbMisses,    // Data TLB read misses
+    Count
+};
+
+// Counters the OS keeps for every process, available without a PMU
+struct SoftCounters {
+    long minor_faults = 0;
+    long major_faults = 0;
+    long context_switches = 0;  // Voluntary and involuntary
+};
+
+/**
+ * Hardware counters of this process and the threads it starts, via perf_event_open
+ * (user space only, so perf_event_paranoid <= 2 is enough). Every event is opened on
+ * its own: whatever the CPU, VM or kernel refuses is simply reported as unavailable.
+ * On other platforms only the soft counters work.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // Reset and enable every open counter
+    void start();
+    // Disable the counters and read them
+    void stop();
+
+    [[nodiscard]] bool available(HwEvent event) const { return fds[index(event)] >= 0; }
+    [[nodiscard]] bool any_available() const;
+    // Why the first event could not be opened, empty if it could
+    [[nodiscard]] const std::string& unavailable_reason() const { return reason; }
+
+    // Count between start() and stop(), scaled up if the kernel multiplexed the counter
+    [[nodiscard]] std::optional<std::uint64_t> value(HwEvent event) const;
+    [[nodiscard]] bool multiplexed(HwEvent event) const { return scaled[index(event)]; }
+    [[nodiscard]] const SoftCounters& soft() const { return soft_delta; }
+
+    static const char* name(HwEvent event);
+
+private:
+    static constexpr std::size_t event_count = static_cast<std::size_t>(HwEvent::Count);
+
+    std::array<int, event_count> fds{};
+    std::array<std::uint64_t, event_count> values{};
+    std::array<bool, event_count> scaled{};
+    SoftCounters soft_start;
+    SoftCounters soft_delta;
+    std::string reason;
+
+    static std::size_t index(const HwEvent event) { return static_cast<std::size_t>(event); }
+};
+
+#endif //PERF_COUNTERS_H
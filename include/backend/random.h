@@ -0,0 +1,116 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <array>
+#include <cstdint>
+
+// SplitMix64, used to expand a single seed into generator state
+struct SplitMix64 {
+    std::uint64_t state;
+
+    explicit SplitMix64(const std::uint64_t seed) : state(seed) {}
+
+    std::uint64_t next() {
+        std::uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+};
+
+// xoshiro256** 64-bit generator
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(const std::uint64_t seed) {
+        SplitMix64 init(seed);
+        for (auto& word : s) word = init.next();
+    }
+
+    std::uint64_t next() {
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform double in [0, 1) with full 53-bit precision
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    std::uint64_t s[4]{};
+
+    static std::uint64_t rotl(const std::uint64_t x, const int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+/**
+ * Philox4x32-10 counter-based generator.
+ * Output depends only on (key, counter), so independent streams keyed by
+ * seed and stream id (e.g. a matrix row) can be produced in any order on any thread.
+ */
+class PhiloxStream {
+public:
+    PhiloxStream(const std::uint64_t seed, const std::uint64_t stream)
+        : key{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          stream_lo(static_cast<std::uint32_t>(stream)), stream_hi(static_cast<std::uint32_t>(stream >> 32)) {}
+
+    std::uint32_t next32() {
+        if (buffered == 0) {
+            block = generate(index++);
+            buffered = 4;
+        }
+        return block[4 - buffered--];
+    }
+
+    std::uint64_t next() {
+        const std::uint64_t hi = next32();
+        return hi << 32 | next32();
+    }
+
+    // Uniform double in [0, 1) with full 53-bit precision
+    double uniform() {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+private:
+    using Block = std::array<std::uint32_t, 4>;
+
+    std::array<std::uint32_t, 2> key;
+    std::uint32_t stream_lo;
+    std::uint32_t stream_hi;
+    std::uint64_t index = 0;
+    Block block{};
+    int buffered = 0;
+
+    [[nodiscard]] Block generate(const std::uint64_t counter) const {
+        Block ctr{static_cast<std::uint32_t>(counter), static_cast<std::uint32_t>(counter >> 32), stream_lo, stream_hi};
+        std::array<std::uint32_t, 2> k = key;
+        for (int round = 0; round < 10; round++) {
+            const std::uint64_t p0 = std::uint64_t{0xD2511F53} * ctr[0];
+            const std::uint64_t p1 = std::uint64_t{0xCD9E8D57} * ctr[2];
+            ctr = {
+                static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ k[0],
+                static_cast<std::uint32_t>(p1),
+                static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ k[1],
+                static_cast<std::uint32_t>(p0)
+            };
+            k[0] += 0x9E3779B9;
+            k[1] += 0xBB67AE85;
+        }
+        return ctr;
+    }
+};
+
+#endif //RANDOM_H
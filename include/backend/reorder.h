@@ -0,0 +1,39 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "graph_gen.h"
+
+enum class VertexOrder {
+    Rcm,     // Reverse Cuthill-McKee: BFS from a low-degree vertex, children by ascending degree, reversed
+    Degree,  // Descending degree, hubs packed together at the front
+    Bfs      // Breadth-first discovery order from the lowest id of every component
+};
+
+// Cost and effect of a reorder; a gap is |u - v| over the adjacency entries u -> v
+struct ReorderStats {
+    double order_ms = 0;    // Computing the permutation
+    double relabel_ms = 0;  // Rebuilding the representations under the new ids
+    double gap_before = 0;  // Mean gap
+    double gap_after = 0;
+    long long bandwidth_before = 0;  // Largest gap
+    long long bandwidth_after = 0;
+};
+
+/**
+ * Relabel the vertices so that neighbours get nearby ids. The permutation is computed
+ * (degree sort in parallel, the RCM/BFS sweeps sequentially), then every representation
+ * that was built is rebuilt in parallel in a fresh arena with the new ids and sorted
+ * neighbour rows; the CSR is always kept. graph.ids maps the new ids back to the ones
+ * the graph was created with, composed over repeated reorders.
+ * @param graph Graph
+ * @param order Vertex order
+ * @param threads Worker threads (0 = all cores)
+ * @return Timings and gap statistics
+ */
+extern ReorderStats reorder_graph(Graph& graph, VertexOrder order, int threads = 0);
+
+#endif //REORDER_H
@@ -0,0 +1,115 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef SHARED_ARRAY_H
+#define SHARED_ARRAY_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Fixed-size array of trivially copyable elements whose memory is held by an owner handle.
+ * The owner is either a 64-byte aligned heap block allocated here or anything
+ * else that keeps the memory alive, e.g. a mapped snapshot file, so graph data
+ * can be used in place without copying. Move-only, like the containers it replaces;
+ * share() hands out an explicit second handle.
+ */
+template <typename T>
+class SharedArray {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    static constexpr std::size_t alignment = 64;
+
+    SharedArray() = default;
+
+    explicit SharedArray(const std::size_t n, const T value = T{}) {
+        assign(n, value);
+    }
+
+    // Adopt n elements at data, owner keeps them alive
+    SharedArray(T* data, const std::size_t n, std::shared_ptr<void> owner)
+        : holder(std::move(owner)), ptr(data), count(n) {}
+
+    SharedArray(const SharedArray&) = delete;
+    SharedArray& operator=(const SharedArray&) = delete;
+
+    SharedArray(SharedArray&& other) noexcept
+        : holder(std::move(other.holder)),
+          ptr(std::exchange(other.ptr, nullptr)),
+          count(std::exchange(other.count, 0)) {}
+
+    SharedArray& operator=(SharedArray&& other) noexcept {
+        if (this != &other) {
+            holder = std::move(other.holder);
+            ptr = std::exchange(other.ptr, nullptr);
+            count = std::exchange(other.count, 0);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+    [[nodiscard]] std::size_t bytes() const { return count * sizeof(T); }
+
+    [[nodiscard]] T* data() { return ptr; }
+    [[nodiscard]] const T* data() const { return ptr; }
+    T& operator[](const std::size_t i) { return ptr[i]; }
+    const T& operator[](const std::size_t i) const { return ptr[i]; }
+
+    iterator begin() { return ptr; }
+    iterator end() { return ptr + count; }
+    [[nodiscard]] const_iterator begin() const { return ptr; }
+    [[nodiscard]] const_iterator end() const { return ptr + count; }
+
+    // Fresh heap block of n copies of value
+    void assign(const std::size_t n, const T value) {
+        reallocate(n, 0);
+        std::fill(ptr, ptr + n, value);
+    }
+
+    // Keep the first min(n, size()) elements, value-initialize the rest
+    void resize(const std::size_t n) {
+        const std::size_t kept = std::min(n, count);
+        reallocate(n, kept);
+        std::fill(ptr + kept, ptr + n, T{});
+    }
+
+    // Second handle to the same elements and owner (copy-on-write sharing, see clone_graph)
+    [[nodiscard]] SharedArray share() const { return SharedArray(ptr, count, holder); }
+
+    void clear() {
+        holder.reset();
+        ptr = nullptr;
+        count = 0;
+    }
+
+private:
+    std::shared_ptr<void> holder;
+    T* ptr = nullptr;
+    std::size_t count = 0;
+
+    void reallocate(const std::size_t n, const std::size_t kept) {
+        if (n == 0) {
+            clear();
+            return;
+        }
+        void* block = ::operator new(n * sizeof(T), std::align_val_t{alignment});
+        std::shared_ptr<void> fresh(block, [](void* p) { ::operator delete(p, std::align_val_t{alignment}); });
+        if (kept > 0) std::memcpy(block, ptr, kept * sizeof(T));
+        holder = std::move(fresh);
+        ptr = static_cast<T*>(block);
+        count = n;
+    }
+};
+
+#endif //SHARED_ARRAY_H
@@ -0,0 +1,64 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+
+#include "graph_gen.h"
+
+/**
+ * On-disk layout of a graph snapshot, all integers in host byte order:
+ *   header (128 bytes) | CSR offsets | CSR neighbours | matrix rows (optional) | original ids (optional)
+ * The id section is written only after a reorder (Graph::ids), as ids.original.
+ * Every section starts on a page boundary and the matrix rows keep their
+ * cache line padding, so a mapped file is used in place exactly as in memory.
+ */
+struct SnapshotHeader {
+    char magic[8];              // "LAB7GRPH"
+    std::uint32_t version;
+    std::uint32_t byte_order;   // snapshot_byte_order as written by the producing host
+    std::uint32_t flags;        // snapshot_has_matrix, snapshot_has_ids
+    std::uint32_t offset_bytes; // Width of one CSR offset (4 or 8)
+    std::uint64_t vertices;
+    std::uint64_t entries;      // CSR neighbour entries
+    std::uint64_t offsets_pos;  // Byte positions of the sections
+    std::uint64_t neighbours_pos;
+    std::uint64_t matrix_pos;
+    std::uint64_t matrix_stride; // Words per matrix row including padding
+    std::uint64_t file_bytes;
+    std::uint64_t ids_pos;
+    std::uint8_t reserved[40];
+};
+static_assert(sizeof(SnapshotHeader) == 128);
+
+inline constexpr std::uint32_t snapshot_version = 1;
+inline constexpr std::uint32_t snapshot_byte_order = 0x01020304;
+inline constexpr std::uint32_t snapshot_has_matrix = 1u << 0;
+inline constexpr std::uint32_t snapshot_has_ids = 1u << 1;
+inline constexpr std::uint64_t snapshot_section_alignment = 4096;
+
+/**
+ * Write graph as a binary snapshot (CSR, plus the matrix when it is built and the
+ * original ids when the graph was reordered)
+ * @param graph Graph, the CSR must be built (see ensure_csr)
+ * @param path Output file, replaced atomically (written to path + ".tmp", then renamed)
+ * @return Bytes written
+ */
+extern std::uint64_t save_snapshot(const Graph& graph, const std::string& path);
+
+/**
+ * Map a snapshot and use its CSR and matrix in place (private copy-on-write mapping,
+ * matrix pages are read lazily on first touch). adj_list is left to ensure_list.
+ * The CSR is scanned once: offsets must not decrease and every neighbour id must be
+ * in [0, n), and a stored id map must be a permutation of [0, n). Throws std::runtime_error
+ * on I/O errors and malformed or incompatible files.
+ * @param path Snapshot file
+ * @return Graph backed by the mapping, which stays alive as long as the graph
+ */
+extern Graph load_snapshot(const std::string& path);
+
+#endif //SNAPSHOT_H
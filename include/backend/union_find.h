@@ -0,0 +1,81 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+#include <numeric>
+#include <utility>
+#include <vector>
+
+/**
+ * Sequential disjoint-set forest (union by size, path halving) used for
+ * incremental connectivity. Empty means "not built", connected() in graph_update.h
+ * builds it lazily.
+ */
+class UnionFind {
+public:
+    // n singleton sets
+    void reset(const int n) {
+        parent.resize(n);
+        set_size.assign(n, 1);
+        std::iota(parent.begin(), parent.end(), 0);
+        sets = n;
+    }
+
+    void clear() {
+        parent.clear();
+        set_size.clear();
+        sets = 0;
+    }
+
+    [[nodiscard]] bool empty() const { return parent.empty(); }
+    [[nodiscard]] int size() const { return static_cast<int>(parent.size()); }
+    // Number of disjoint sets
+    [[nodiscard]] int count() const { return sets; }
+
+    // Append a singleton set, returns its element
+    int add() {
+        parent.push_back(size());
+        set_size.push_back(1);
+        sets++;
+        return size() - 1;
+    }
+
+    int find(int v) {
+        while (parent[v] != v) {
+            parent[v] = parent[parent[v]];
+            v = parent[v];
+        }
+        return v;
+    }
+
+    // Merge the sets of u and v, false if they were already one set
+    bool unite(const int u, const int v) {
+        int a = find(u), b = find(v);
+        if (a == b) return false;
+        if (set_size[a] < set_size[b]) std::swap(a, b);
+        parent[b] = a;
+        set_size[a] += set_size[b];
+        sets--;
+        return true;
+    }
+
+    // Hang singleton v under root; seeds the forest from precomputed components
+    void attach(const int v, const int root) {
+        if (v == root) return;
+        parent[v] = root;
+        set_size[root]++;
+        sets--;
+    }
+
+    [[nodiscard]] bool same(const int u, const int v) { return find(u) == find(v); }
+
+private:
+    std::vector<int> parent;
+    std::vector<int> set_size;
+    int sets = 0;
+};
+
+#endif //UNION_FIND_H
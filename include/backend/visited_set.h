@@ -0,0 +1,62 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef VISITED_SET_H
+#define VISITED_SET_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "bit_matrix.h"
+
+/**
+ * Visited bitset with O(1) reset between traversals.
+ * Every 64-bit word carries the epoch it was last written in; words stamped with
+ * an older epoch read as zero, so starting a new traversal only bumps the epoch.
+ */
+class VisitedSet {
+public:
+    using word_t = BitMatrix::word_t;
+    static constexpr int word_bits = BitMatrix::word_bits;
+
+    // Size for n vertices and start a new, empty epoch
+    void prepare(const int n) {
+        if (const std::size_t words = BitMatrix::words_for(n); words != bits.size()) {
+            bits.assign(words, 0);
+            stamps.assign(words, 0);
+            epoch = 0;
+        }
+        if (++epoch == 0) {
+            // Wrapped around, old stamps could alias the new epoch
+            std::ranges::fill(stamps, 0);
+            epoch = 1;
+        }
+    }
+
+    // Current-epoch view of word w
+    [[nodiscard]] word_t word(const std::size_t w) const {
+        return stamps[w] == epoch ? bits[w] : 0;
+    }
+
+    [[nodiscard]] bool test(const int v) const {
+        return (word(v / word_bits) >> (v % word_bits) & 1u) != 0;
+    }
+
+    void set(const int v) {
+        const std::size_t w = v / word_bits;
+        if (stamps[w] != epoch) {
+            stamps[w] = epoch;
+            bits[w] = 0;
+        }
+        bits[w] |= word_t{1} << (v % word_bits);
+    }
+
+private:
+    std::vector<word_t> bits;
+    std::vector<std::uint32_t> stamps;
+    std::uint32_t epoch = 0;
+};
+
+#endif //VISITED_SET_H
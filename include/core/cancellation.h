@@ -0,0 +1,62 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+
+// Thrown by check_cancelled() on the thread that runs a cancelled job
+class Cancelled : public std::runtime_error {
+public:
+    Cancelled() : std::runtime_error("cancelled") {}
+};
+
+// Cancellation request and progress (done of total work units) of one background job
+struct JobControl {
+    std::atomic<bool> cancel{false};
+    std::atomic<std::int64_t> done{0};
+    std::atomic<std::int64_t> total{0};
+};
+
+/**
+ * Job whose command runs on this thread, set by the console around it and handed to
+ * parallel_for workers. Per thread, so a foreground command next to a job never sees
+ * the job's cancel flag; without a job every poll below is one pointer test.
+ */
+inline thread_local JobControl* current_job = nullptr;
+
+/**
+ * Polled by long backend loops. Inside parallel_for bodies only cancel_requested() may
+ * be used (skip the remaining work, an exception there would terminate), the caller
+ * then calls check_cancelled() once the workers have joined.
+ */
+inline bool cancel_requested() {
+    const JobControl* job = current_job;
+    return job != nullptr && job->cancel.load(std::memory_order_relaxed);
+}
+
+inline void check_cancelled() {
+    if (cancel_requested()) throw Cancelled();
+}
+
+// Start progress reporting of the running job at 0 of total
+inline void progress_begin(const std::int64_t total) {
+    if (JobControl* job = current_job) {
+        job->done.store(0, std::memory_order_relaxed);
+        job->total.store(total, std::memory_order_relaxed);
+    }
+}
+
+inline void progress_set(const std::int64_t done) {
+    if (JobControl* job = current_job) job->done.store(done, std::memory_order_relaxed);
+}
+
+inline void progress_add(const std::int64_t done) {
+    if (JobControl* job = current_job) job->done.fetch_add(done, std::memory_order_relaxed);
+}
+
+#endif //CANCELLATION_H
@@ -1,8 +1,18 @@
 #ifndef UNIVERSAL_CONSOLE_H
 #define UNIVERSAL_CONSOLE_H
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
 #include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <functional>
 #include <iomanip>
@@ -10,8 +20,11 @@
 #include <iostream>
 #include <ranges>
 #include <sstream>
+#include <stdexcept>
 
 #include "../config/config_loader.h"
+#include "cancellation.h"
+#include "latency_histogram.h"
 
 #ifdef _WIN32
 #ifndef NOMINMAX
@@ -31,12 +44,61 @@ using namespace std;
 class Console {
 public:
     using CommandHandler = std::function<void(const std::vector<std::string>&)>;
+    // Running total of heap allocations, provided by the host program if it counts them
+    using AllocationCounter = std::function<std::uint64_t()>;
+    // Lock a command holds while it runs, nullopt when what it needs is busy (see set_command_guard)
+    using CommandGuard = std::function<std::optional<std::unique_lock<std::recursive_mutex>>(
+        const std::vector<std::string>& tokens, bool wait)>;
 
     Console() : running(false) {
         config.prompt = "> ";
         config.welcome_msg = "Console v0.0.1";
+
+        register_command("perf",
+            [this](const std::vector<std::string>& args) { perf_report(args); },
+            "Latency per command since start (count, p50/p99/max, allocations)",
+            {"--json <file> (also dump as JSON)", "--reset (clear all counters)"},
+            "perf [--json file] [--reset]"
+        );
+        // Listed for help only: process_input strips the prefix itself, so the inner command is what gets recorded
+        register_command("time",
+            [this](const std::vector<std::string>& args) {
+                std::string command;
+                for (const auto& arg : args) command += arg + " ";
+                run_timed(command);
+            },
+            "Run a command and report its wall time and allocations",
+            {"command", "args..."},
+            "time <command> [args...]"
+        );
+        // Job control, also intercepted by process_input: it must not wait for the command lock
+        register_command("jobs",
+            [this](const std::vector<std::string>&) { list_jobs(); },
+            "List background jobs ('<command> &' starts one) with state, elapsed time and progress",
+            {},
+            "jobs"
+        );
+        register_command("cancel",
+            [this](const std::vector<std::string>& args) { cancel_job(args); },
+            "Stop a background job at its next cancellation point",
+            {"id"},
+            "cancel <id>"
+        );
+        register_command("wait",
+            [this](const std::vector<std::string>& args) { wait_jobs(args); },
+            "Block until a background job (or all of them) finishes and show its output",
+            {"id (optional)"},
+            "wait [id]"
+        );
+    }
+
+    ~Console() {
+        finish_jobs(true);
     }
 
+    Console(const Console&) = delete;
+    Console& operator=(const Console&) = delete;
+
     void register_command(const std::string& name, const CommandHandler &handler,
                          const std::string& description = "",
                          const std::vector<std::string>& parameters = {},
@@ -66,12 +128,13 @@ public:
             clear_screen();
         }
 
-        std::cout << get_color("info") << config.welcome_msg << reset_color() << std::endl;
-        std::cout << "Type 'help' for available commands" << std::endl;
+        out() << get_color("info") << config.welcome_msg << reset_color() << std::endl;
+        out() << "Type 'help' for available commands" << std::endl;
 
         while (running) {
-            std::cout << get_color("info") << config.prompt << reset_color();
-            std::getline(std::cin, input);
+            report_jobs();
+            out() << get_color("info") << config.prompt << reset_color() << std::flush;
+            if (!std::getline(std::cin, input)) break;
 
             if (input.empty()) continue;
 
@@ -79,11 +142,108 @@ public:
             process_input(input);
 
         }
+        // exit cancels what is still running, end of input lets it finish
+        finish_jobs(!running);
+    }
+
+    /**
+     * Run commands back to back without welcome, prompt or colors; stdout is written in
+     * large blocks. Stops at the first failing command (background jobs included) or at
+     * exit/quit; jobs still running at the end are waited for, or cancelled after a stop.
+     * @return Process exit status: 0, or 1 after a failure
+     */
+    int run_batch(const std::vector<std::string>& script) {
+        batch = true;
+        config.colors_enabled = false;
+        running = true;
+
+        std::streambuf* const stdout_buffer = std::cout.rdbuf();
+        BlockBuffer block(stdout_buffer);
+        std::cout.rdbuf(&block);
+
+        int status = EXIT_SUCCESS;
+        for (size_t i = 0; i < script.size() && running; i++) {
+            if (process_input(script[i]) && report_jobs()) continue;
+            block.drain();
+            std::cerr << "Command " << (i + 1) << " failed: " << script[i] << std::endl;
+            status = EXIT_FAILURE;
+            break;
+        }
+        if (!finish_jobs(status == EXIT_FAILURE || !running) && status == EXIT_SUCCESS) {
+            block.drain();
+            std::cerr << "Background job failed" << std::endl;
+            status = EXIT_FAILURE;
+        }
+
+        block.drain();
+        std::cout.rdbuf(stdout_buffer);
+        return status;
+    }
+
+    // Commands of a script: one or more ';'-separated commands per line, '#' starts a comment line
+    static std::vector<std::string> split_commands(const std::string& text) {
+        std::vector<std::string> result;
+        std::istringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (const size_t first = line.find_first_not_of(" \t\r"); first == std::string::npos || line[first] == '#') {
+                continue;
+            }
+            std::istringstream parts(line);
+            std::string command;
+            while (std::getline(parts, command, ';')) {
+                const size_t begin = command.find_first_not_of(" \t\r");
+                if (begin != std::string::npos) {
+                    result.push_back(command.substr(begin, command.find_last_not_of(" \t\r") - begin + 1));
+                }
+            }
+        }
+        return result;
+    }
+
+    static std::vector<std::string> read_script(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("cannot open script " + path);
+        std::ostringstream text;
+        text << file.rdbuf();
+        return split_commands(text.str());
+    }
+
+    void set_allocation_counter(AllocationCounter counter) {
+        allocation_counter = std::move(counter);
+    }
+
+    /**
+     * Replace the console-wide command lock by finer ones, so the prompt stays usable
+     * while a job runs. The guard gets the command's tokens and whether it may block
+     * (jobs wait for the foreground, never the other way round), and returns the lock
+     * to hold (an empty one if nothing is needed) or nullopt if that is busy.
+     */
+    void set_command_guard(CommandGuard guard) {
+        command_guard = std::move(guard);
+    }
+
+    // Run one command line as if it was typed, false if it failed
+    bool execute(const std::string& input) {
+        return process_input(input);
+    }
+
+    // Mark the running command as failed (a batch run stops after it)
+    void fail() const { failed = true; }
+
+    // Stream for the console's own messages, std::cout unless jobs run next to the foreground
+    [[nodiscard]] std::ostream& out() const {
+        return foreground && JobOutput::capture == nullptr ? *foreground : std::cout;
     }
 
     void stop() {
+        if (JobOutput::capture != nullptr) {
+            out() << get_color("error") << "exit is not available in a background job" << reset_color() << std::endl;
+            fail();
+            return;
+        }
         running = false;
-        std::cout << get_color("success") << config.exit_msg << reset_color() << std::endl;
+        if (!batch) out() << get_color("success") << config.exit_msg << reset_color() << std::endl;
     }
 
     static std::vector<std::string> tokenize(const std::string& input) {
@@ -99,20 +259,20 @@ public:
     }
 
     void print_help() {
-        std::cout << get_color("info") << "Available commands:" << reset_color() << std::endl;
+        out() << get_color("info") << "Available commands:" << reset_color() << std::endl;
         size_t max_name_length = 12;
         for (const auto &name: commands | views::keys) {
             max_name_length = std::max(max_name_length, name.length());
         }
 
         for (const auto& [name, info] : commands) {
-            std::cout << "  " << get_color("success") << std::setw(static_cast<int>(max_name_length))
-                      << std::left << name << reset_color() << " - " << info.description;
+            out() << "  " << get_color("success") << std::setw(static_cast<int>(max_name_length))
+                  << std::left << name << reset_color() << " - " << info.description;
 
             if (!info.usage.empty()) {
-                std::cout << " " << get_color("warning") << "(" << info.usage << ")" << reset_color();
+                out() << " " << get_color("warning") << "(" << info.usage << ")" << reset_color();
             }
-            std::cout << std::endl;
+            out() << std::endl;
         }
     }
 
@@ -121,18 +281,19 @@ public:
 
         if (auto it = commands.find(resolved); it != commands.end()) {
             const auto& info = it->second;
-            std::cout << get_color("info") << "Command: " << resolved << reset_color() << std::endl;
-            std::cout << "  Description: " << info.description << std::endl;
-            std::cout << "  Usage: " << get_color("success") << info.usage << reset_color() << std::endl;
+            out() << get_color("info") << "Command: " << resolved << reset_color() << std::endl;
+            out() << "  Description: " << info.description << std::endl;
+            out() << "  Usage: " << get_color("success") << info.usage << reset_color() << std::endl;
 
             if (!info.parameters.empty()) {
-                std::cout << "  Parameters:" << std::endl;
+                out() << "  Parameters:" << std::endl;
                 for (const auto& param : info.parameters) {
-                    std::cout << "    - " << param << std::endl;
+                    out() << "    - " << param << std::endl;
                 }
             }
         } else {
-            std::cout << get_color("error") << "Unknown command: " << command_name << reset_color() << std::endl;
+            out() << get_color("error") << "Unknown command: " << command_name << reset_color() << std::endl;
+            fail();
         }
     }
 
@@ -151,6 +312,7 @@ public:
     }
 
     void clear_screen() {
+        if (batch) return;
 #ifdef _WIN32
         std::system("cls");
 #else
@@ -159,14 +321,18 @@ public:
     }
 
     void show_history() {
-        std::cout << get_color("info") << "Command history (last " << command_history.size() << " commands):" << reset_color() << std::endl;
+        out() << get_color("info") << "Command history (last " << command_history.size() << " commands):" << reset_color() << std::endl;
         for (size_t i = 0; i < command_history.size(); ++i) {
-            std::cout << "  " << (i + 1) << ": " << command_history[i] << std::endl;
+            out() << "  " << (i + 1) << ": " << command_history[i] << std::endl;
         }
     }
 
 private:
     bool running;
+    bool batch = false;
+    // Per thread: the foreground and the job worker each run their own command
+    inline static thread_local bool failed = false;
+    inline static thread_local int command_depth = 0;  // Registered commands running on this thread
     std::deque<std::string> commands_history;
     ConsoleConfig config;
     std::deque<std::string> command_history;
@@ -176,8 +342,16 @@ private:
         std::string description;
         std::vector<std::string> parameters;
         std::string usage;
+        LatencyHistogram latency;     // Every run, failed ones included
+        std::uint64_t allocations = 0;
     };
 
+    AllocationCounter allocation_counter;
+
+    std::uint64_t allocations() const {
+        return allocation_counter ? allocation_counter() : 0;
+    }
+
     std::unordered_map<std::string, CommandInfo> commands;
     std::unordered_map<std::string, std::string> aliases;
 
@@ -186,15 +360,116 @@ private:
         return it != aliases.end() ? it->second : input;
     }
 
-    void process_input(const std::string& input) {
+    // Collects stdout for batch runs, so std::endl no longer costs a write per line
+    class BlockBuffer final : public std::streambuf {
+    public:
+        explicit BlockBuffer(std::streambuf* sink) : target(sink), block(size_t{1} << 16) {
+            setp(block.data(), block.data() + block.size());
+        }
+
+        void drain() {
+            target->sputn(pbase(), pptr() - pbase());
+            target->pubsync();
+            setp(block.data(), block.data() + block.size());
+        }
+
+    protected:
+        int_type overflow(const int_type ch) override {
+            drain();
+            if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                *pptr() = traits_type::to_char_type(ch);
+                pbump(1);
+            }
+            return traits_type::not_eof(ch);
+        }
+
+        // Flushes are deferred to the next full block or drain()
+        int sync() override { return 0; }
+
+    private:
+        std::streambuf* target;
+        std::vector<char> block;
+    };
+
+    // Command started with '&', run by the job worker
+    struct Job {
+        enum class State { Queued, Running, Done, Failed, Cancelled };
+
+        int id = 0;
+        std::string command;
+        State state = State::Queued;
+        JobControl control;
+        std::chrono::steady_clock::time_point submitted, started, finished;
+        std::string output;  // What the command wrote to std::cout, shown when the job is reported
+
+        [[nodiscard]] bool done() const { return state != State::Queued && state != State::Running; }
+    };
+
+    // Installed on std::cout while jobs exist: the job thread writes into its job, others pass through.
+    // Unbuffered, so the two threads never share a put area.
+    class JobOutput final : public std::streambuf {
+    public:
+        inline static thread_local std::string* capture = nullptr;
+
+        explicit JobOutput(std::streambuf* sink) : target(sink) {}
+
+        [[nodiscard]] std::streambuf* sink() const { return target; }
+
+    protected:
+        int_type overflow(const int_type ch) override {
+            if (traits_type::eq_int_type(ch, traits_type::eof())) return traits_type::not_eof(ch);
+            if (capture != nullptr) capture->push_back(traits_type::to_char_type(ch));
+            else target->sputc(traits_type::to_char_type(ch));
+            return ch;
+        }
+
+        std::streamsize xsputn(const char* text, const std::streamsize count) override {
+            if (capture != nullptr) capture->append(text, static_cast<size_t>(count));
+            else target->sputn(text, count);
+            return count;
+        }
+
+        int sync() override { return capture != nullptr ? 0 : target->pubsync(); }
+
+    private:
+        std::streambuf* target;
+    };
+
+    CommandGuard command_guard;          // Host locking, see set_command_guard
+    std::recursive_mutex command_mutex;  // Otherwise held while a registered command runs, so jobs never overlap the foreground
+    std::mutex stats_mutex;              // Latency and allocations of commands, recorded by both threads
+    std::mutex jobs_mutex;               // Guards everything below
+    std::condition_variable jobs_changed;
+    std::deque<std::unique_ptr<Job>> jobs;  // Submission order, dropped once reported
+    std::unique_ptr<JobOutput> job_output;
+    // The console's own output while jobs exist: std::cout (and its formatting state) then belongs to the
+    // job thread, the foreground writes to the same sink through this stream
+    std::unique_ptr<std::ostream> foreground;
+    std::ostream* input_tie = nullptr;  // std::cin's tie, detached from std::cout meanwhile
+    std::thread job_worker;
+    bool jobs_stopping = false;
+    int next_job_id = 1;
+
+    // Returns false if the command is unknown, throws or reports a failure
+    bool process_input(const std::string& input) {
+        failed = false;
         auto tokens = tokenize(input);
-        if (tokens.empty()) return;
+        if (tokens.empty()) return true;
+
+        // Only a standalone trailing '&' starts a job, an argument ending in '&' is left alone
+        if (tokens.back() == "&") {
+            return submit_job(input.substr(0, input.find_last_of('&')));
+        }
 
         std::string commandName = tokens[0];
 
         if (commandName == "exit" || commandName == "quit") {
             stop();
-            return;
+            return true;
+        }
+
+        if (commandName == "time") {
+            return run_timed(input.substr(input.find("time") + 4));
         }
 
         if (commandName == "help") {
@@ -203,17 +478,25 @@ private:
             } else {
                 print_help();
             }
-            return;
+            return !failed;
         }
 
         if (commandName == "clear") {
             clear_screen();
-            return;
+            return true;
         }
 
         if (commandName == "history") {
             show_history();
-            return;
+            return true;
+        }
+
+        if (commandName == "jobs" || commandName == "cancel" || commandName == "wait") {
+            const std::vector<std::string> args(tokens.begin() + 1, tokens.end());
+            if (commandName == "jobs") list_jobs();
+            else if (commandName == "cancel") cancel_job(args);
+            else wait_jobs(args);
+            return !failed;
         }
 
         std::string resolvedCommand = resolve_command(commandName);
@@ -224,16 +507,355 @@ private:
         commandName = resolvedCommand;
 
         if (const auto it = commands.find(commandName); it != commands.end()) {
+            const auto command_lock = claim(tokens);
+            if (!command_lock) {
+                out() << get_color("error") << "Busy: a background job is using what '" << commandName
+                      << "' needs, use 'wait' or 'cancel <id>'" << reset_color() << std::endl;
+                fail();
+                return false;
+            }
+            const std::uint64_t allocations_before = allocations();
+            const auto start = std::chrono::steady_clock::now();
+            command_depth++;
             try {
                 const std::vector<std::string> args(tokens.begin() + 1, tokens.end());
                 it->second.handler(args);
             } catch (const std::exception& e) {
-                std::cout << get_color("error") << "Error executing command: " << e.what() << reset_color() << std::endl;
+                out() << get_color("error") << "Error executing command: " << e.what() << reset_color() << std::endl;
+                fail();
             }
+            command_depth--;
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            const std::lock_guard stats_lock(stats_mutex);
+            it->second.latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            it->second.allocations += allocations() - allocations_before;
         } else {
-            std::cout << get_color("error") << config.unknown_msg << ": " << commandName << reset_color() << std::endl;
+            out() << get_color("error") << config.unknown_msg << ": " << commandName << reset_color() << std::endl;
             if (config.show_help_on_unknown) {
-                std::cout << "Type 'help' for available commands" << std::endl;
+                out() << "Type 'help' for available commands" << std::endl;
+            }
+            fail();
+        }
+        return !failed;
+    }
+
+    // Lock for a registered command: the guard's, else the console-wide one
+    std::optional<std::unique_lock<std::recursive_mutex>> claim(const std::vector<std::string>& tokens) {
+        const bool wait = JobOutput::capture != nullptr;
+        if (command_guard) return command_guard(tokens, wait);
+        std::unique_lock lock(command_mutex, std::defer_lock);
+        if (wait) lock.lock();
+        else if (!lock.try_lock()) return std::nullopt;
+        return lock;
+    }
+
+    // "time <cmd>": run cmd and report its wall time (and allocations when counted)
+    bool run_timed(const std::string& command) {
+        if (tokenize(command).empty()) {
+            out() << get_color("error") << "Usage: time <command> [args...]" << reset_color() << std::endl;
+            fail();
+            return false;
+        }
+
+        const std::uint64_t allocations_before = allocations();
+        const auto start = std::chrono::steady_clock::now();
+        const bool ok = process_input(command);
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        out() << get_color("info") << "time: " << std::fixed << std::setprecision(3) << elapsed.count() << " ms";
+        if (allocation_counter) out() << ", " << allocations() - allocations_before << " allocations";
+        out() << std::defaultfloat << std::setprecision(6) << reset_color() << std::endl;
+        return ok;
+    }
+
+    // "<command> &": queue the command for the job worker and return at once
+    bool submit_job(const std::string& command) {
+        const auto tokens = tokenize(command);
+        // Look through "time" prefixes: "time wait &" would otherwise wait for itself
+        const auto first = std::ranges::find_if(tokens, [](const std::string& token) { return token != "time"; });
+        const std::string name = first == tokens.end() ? "" : resolve_command(*first);
+        if (name.empty() || name == "exit" || name == "quit" || name == "jobs" || name == "cancel" || name == "wait") {
+            out() << get_color("error") << "Usage: <command> [args...] &  (not for exit, jobs, cancel, wait)"
+                  << reset_color() << std::endl;
+            fail();
+            return false;
+        }
+        if (JobOutput::capture != nullptr) {
+            out() << get_color("error") << "Jobs cannot start other jobs" << reset_color() << std::endl;
+            fail();
+            return false;
+        }
+
+        const std::lock_guard lock(jobs_mutex);
+        if (!job_output) {
+            job_output = std::make_unique<JobOutput>(std::cout.rdbuf());
+            foreground = std::make_unique<std::ostream>(job_output->sink());
+            std::cout.rdbuf(job_output.get());
+            input_tie = std::cin.tie(nullptr);
+        }
+        if (!job_worker.joinable()) {
+            jobs_stopping = false;
+            job_worker = std::thread([this] { job_loop(); });
+        }
+
+        auto job = std::make_unique<Job>();
+        job->id = next_job_id++;
+        job->command = command.substr(command.find_first_not_of(" \t"), command.find_last_not_of(" \t") + 1);
+        job->submitted = std::chrono::steady_clock::now();
+        out() << "[" << job->id << "] " << job->command << std::endl;
+        jobs.push_back(std::move(job));
+        jobs_changed.notify_all();
+        return true;
+    }
+
+    // Job worker: runs queued jobs one at a time until stopped, each command takes its locks like the foreground
+    void job_loop() {
+        std::unique_lock lock(jobs_mutex);
+        while (true) {
+            const auto next = std::ranges::find_if(jobs, [](const auto& job) { return job->state == Job::State::Queued; });
+            if (next == jobs.end()) {
+                if (jobs_stopping) return;
+                jobs_changed.wait(lock);
+                continue;
+            }
+            Job& job = **next;
+            job.state = Job::State::Running;
+            job.started = std::chrono::steady_clock::now();
+            lock.unlock();
+
+            JobOutput::capture = &job.output;
+            current_job = &job.control;
+            const bool ok = process_input(job.command);
+            current_job = nullptr;
+            JobOutput::capture = nullptr;
+
+            lock.lock();
+            job.finished = std::chrono::steady_clock::now();
+            job.state = job.control.cancel ? Job::State::Cancelled : ok ? Job::State::Done : Job::State::Failed;
+            jobs_changed.notify_all();
+        }
+    }
+
+    Job* find_job(const int id) {
+        const auto it = std::ranges::find_if(jobs, [id](const auto& job) { return job->id == id; });
+        return it == jobs.end() ? nullptr : it->get();
+    }
+
+    static const char* state_name(const Job::State state) {
+        switch (state) {
+            case Job::State::Queued: return "queued";
+            case Job::State::Running: return "running";
+            case Job::State::Done: return "done";
+            case Job::State::Failed: return "failed";
+            case Job::State::Cancelled: return "cancelled";
+        }
+        return "";
+    }
+
+    void list_jobs() {
+        const std::lock_guard lock(jobs_mutex);
+        if (jobs.empty()) {
+            out() << "No jobs" << std::endl;
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        std::ostringstream listing;
+        listing << std::fixed << std::setprecision(1);
+        for (const auto& job : jobs) {
+            const auto since = job->state == Job::State::Queued ? job->submitted : job->started;
+            const std::chrono::duration<double> elapsed = (job->done() ? job->finished : now) - since;
+            listing << "  [" << job->id << "] " << std::left << std::setw(10) << state_name(job->state) << std::right
+                    << std::setw(9) << elapsed.count() << " s";
+            const std::int64_t total = job->control.total.load(std::memory_order_relaxed);
+            if (total > 0 && job->state == Job::State::Running) {
+                const std::int64_t done = std::min(job->control.done.load(std::memory_order_relaxed), total);
+                listing << std::setw(7) << 100.0 * static_cast<double>(done) / static_cast<double>(total) << "%";
+            } else {
+                listing << std::setw(8) << "";
+            }
+            listing << "  " << job->command << '\n';
+        }
+        out() << listing.str() << std::flush;
+    }
+
+    void cancel_job(const std::vector<std::string>& args) {
+        int id = 0;
+        try {
+            if (args.empty()) throw std::invalid_argument("missing id");
+            id = std::stoi(args[0]);
+        } catch (const std::exception&) {
+            out() << get_color("error") << "Usage: cancel <id>" << reset_color() << std::endl;
+            fail();
+            return;
+        }
+
+        const std::lock_guard lock(jobs_mutex);
+        Job* job = find_job(id);
+        if (job == nullptr || job->done()) {
+            out() << get_color("error") << "No running job " << id << reset_color() << std::endl;
+            fail();
+            return;
+        }
+        job->control.cancel = true;
+        if (job->state == Job::State::Queued) {
+            job->state = Job::State::Cancelled;
+            job->started = job->finished = std::chrono::steady_clock::now();
+        }
+        out() << "[" << id << "] cancelling" << std::endl;
+        jobs_changed.notify_all();
+    }
+
+    void wait_jobs(const std::vector<std::string>& args) {
+        // On the worker it would wait for its own job ("profile wait &"), inside a command for
+        // jobs that need the locks the command holds
+        if (JobOutput::capture != nullptr || command_depth > 0) {
+            out() << get_color("error") << "wait is not available in a background job or inside another command"
+                  << reset_color() << std::endl;
+            fail();
+            return;
+        }
+        int id = 0;
+        try {
+            if (!args.empty()) id = std::stoi(args[0]);
+        } catch (const std::exception&) {
+            out() << get_color("error") << "Usage: wait [id]" << reset_color() << std::endl;
+            fail();
+            return;
+        }
+
+        {
+            std::unique_lock lock(jobs_mutex);
+            if (id != 0 && find_job(id) == nullptr) {
+                out() << get_color("error") << "No job " << id << reset_color() << std::endl;
+                fail();
+                return;
+            }
+            jobs_changed.wait(lock, [&] {
+                if (id != 0) return find_job(id)->done();
+                return std::ranges::all_of(jobs, [](const auto& job) { return job->done(); });
+            });
+        }
+        if (!report_jobs()) fail();
+    }
+
+    // Print and drop finished jobs with their output, like a shell before its prompt; false if one failed
+    bool report_jobs() {
+        std::vector<std::unique_ptr<Job>> finished;
+        {
+            const std::lock_guard lock(jobs_mutex);
+            for (auto& job : jobs) {
+                if (job->done()) finished.push_back(std::move(job));
+            }
+            std::erase(jobs, nullptr);
+        }
+
+        bool ok = true;
+        for (const auto& job : finished) {
+            const std::chrono::duration<double, std::milli> elapsed = job->finished - job->started;
+            out() << get_color(job->state == Job::State::Done ? "success" : "error") << "[" << job->id << "] "
+                  << state_name(job->state) << " (" << elapsed.count() << " ms): " << job->command
+                  << reset_color() << std::endl;
+            out() << job->output << std::flush;
+            ok = ok && job->state != Job::State::Failed;
+        }
+        return ok;
+    }
+
+    /**
+     * Let the worker drain the queue (cancelling every job first if asked), stop it and
+     * give std::cout back its own buffer
+     * @return false if a job failed
+     */
+    bool finish_jobs(const bool cancel) {
+        {
+            const std::lock_guard lock(jobs_mutex);
+            for (const auto& job : jobs) {
+                if (!cancel || job->done()) continue;
+                job->control.cancel = true;
+                if (job->state == Job::State::Queued) {
+                    job->state = Job::State::Cancelled;
+                    job->started = job->finished = std::chrono::steady_clock::now();
+                }
+            }
+            jobs_stopping = true;
+            jobs_changed.notify_all();
+        }
+        if (job_worker.joinable()) job_worker.join();
+        if (job_output) {
+            foreground->flush();
+            foreground.reset();
+            std::cin.tie(input_tie);
+            std::cout.rdbuf(job_output->sink());
+            job_output.reset();
+        }
+        return report_jobs();
+    }
+
+    void perf_report(const std::vector<std::string>& args) {
+        std::string json_path;
+        bool reset = false;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (args[i] == "--json" && i + 1 < args.size()) json_path = args[++i];
+            else if (args[i] == "--reset") reset = true;
+            else {
+                out() << get_color("error") << "Usage: perf [--json file] [--reset]" << reset_color() << std::endl;
+                fail();
+                return;
+            }
+        }
+
+        const std::lock_guard stats_lock(stats_mutex);
+        // Slowest commands in total first
+        std::vector<std::pair<std::string, const CommandInfo*>> used;
+        for (const auto& [name, info] : commands) {
+            if (info.latency.count() > 0) used.emplace_back(name, &info);
+        }
+        std::ranges::sort(used, [](const auto& a, const auto& b) {
+            return a.second->latency.total() > b.second->latency.total();
+        });
+
+        const auto ms = [](const std::uint64_t ns) { return static_cast<double>(ns) / 1e6; };
+        out() << std::left << std::setw(14) << "command" << std::right << std::setw(8) << "count"
+              << std::setw(12) << "p50 ms" << std::setw(12) << "p99 ms" << std::setw(12) << "max ms"
+              << std::setw(12) << "total ms";
+        if (allocation_counter) out() << std::setw(14) << "allocs/call";
+        out() << std::endl << std::fixed << std::setprecision(3);
+        for (const auto& [name, info] : used) {
+            const LatencyHistogram& latency = info->latency;
+            out() << std::left << std::setw(14) << name << std::right << std::setw(8) << latency.count()
+                  << std::setw(12) << ms(latency.percentile(0.5)) << std::setw(12) << ms(latency.percentile(0.99))
+                  << std::setw(12) << ms(latency.max()) << std::setw(12) << ms(latency.total());
+            if (allocation_counter) {
+                out() << std::setw(14) << static_cast<double>(info->allocations) / static_cast<double>(latency.count());
+            }
+            out() << std::endl;
+        }
+        out() << std::defaultfloat << std::setprecision(6);
+
+        if (!json_path.empty()) {
+            std::ofstream file(json_path);
+            file << "{\n  \"commands\": [";
+            for (size_t i = 0; i < used.size(); i++) {
+                const LatencyHistogram& latency = used[i].second->latency;
+                file << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << used[i].first << "\", \"count\": " << latency.count()
+                     << ", \"p50_ns\": " << latency.percentile(0.5) << ", \"p99_ns\": " << latency.percentile(0.99)
+                     << ", \"max_ns\": " << latency.max() << ", \"total_ns\": " << latency.total();
+                if (allocation_counter) file << ", \"allocations\": " << used[i].second->allocations;
+                file << "}";
+            }
+            file << "\n  ]\n}\n";
+            if (!file) {
+                out() << get_color("error") << "Failed to write " << json_path << reset_color() << std::endl;
+                fail();
+            } else {
+                out() << "Written to " << json_path << std::endl;
+            }
+        }
+
+        if (reset) {
+            for (auto& info : commands | views::values) {
+                info.latency.reset();
+                info.allocations = 0;
             }
         }
     }
@@ -0,0 +1,67 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Log-linear latency histogram in nanoseconds: every power of two is split into
+ * 8 buckets, so percentiles are within 12.5% of the true value. record() is a
+ * couple of integer ops, cheap enough to stay on for every command.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int sub_bits = 3;
+    static constexpr int sub_count = 1 << sub_bits;
+    static constexpr int bucket_count = (64 - sub_bits + 1) * sub_count;
+
+    void record(const std::uint64_t ns) {
+        buckets[index(ns)]++;
+        samples++;
+        sum += ns;
+        largest = std::max(largest, ns);
+    }
+
+    void reset() { *this = LatencyHistogram(); }
+
+    [[nodiscard]] std::uint64_t count() const { return samples; }
+    [[nodiscard]] std::uint64_t total() const { return sum; }
+    [[nodiscard]] std::uint64_t max() const { return largest; }
+
+    // Upper bound of the bucket holding the q-quantile (0 < q <= 1), never above max()
+    [[nodiscard]] std::uint64_t percentile(const double q) const {
+        if (samples == 0) return 0;
+        const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(samples))));
+        std::uint64_t seen = 0;
+        for (int i = 0; i < bucket_count; i++) {
+            seen += buckets[i];
+            if (seen >= rank) return std::min(upper_bound(i), largest);
+        }
+        return largest;
+    }
+
+private:
+    std::array<std::uint64_t, bucket_count> buckets{};
+    std::uint64_t samples = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t largest = 0;
+
+    static int index(const std::uint64_t ns) {
+        if (ns < sub_count) return static_cast<int>(ns);
+        const int exponent = std::bit_width(ns) - 1;
+        const auto sub = static_cast<int>((ns >> (exponent - sub_bits)) & (sub_count - 1));
+        return (exponent - sub_bits + 1) * sub_count + sub;
+    }
+
+    static std::uint64_t upper_bound(const int i) {
+        if (i < sub_count) return static_cast<std::uint64_t>(i);
+        const int shift = i / sub_count - 1;
+        const std::uint64_t lower = static_cast<std::uint64_t>(sub_count + i % sub_count) << shift;
+        return lower + ((std::uint64_t{1} << shift) - 1);
+    }
+};
+
+#endif //LATENCY_HISTOGRAM_H
@@ -9,21 +9,111 @@
 #include <windows.h>
 #include <shlobj.h>
 #else
+#include <pwd.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
 #include <stdio.h>
 #endif
 
 #include "../include/adapters/console_adapter.h"
+#include "../include/backend/bfs.h"
+#include "../include/backend/components.h"
+#include "../include/backend/edge_import.h"
+#include "../include/backend/graph_convert.h"
 #include "../include/backend/graph_gen.h"
+#include "../include/backend/graph_render.h"
+#include "../include/backend/graph_update.h"
+#include "../include/backend/metrics.h"
+#include "../include/backend/parallel.h"
+#include "../include/backend/perf_counters.h"
+#include "../include/backend/reorder.h"
+#include "../include/backend/snapshot.h"
 
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <iomanip>
+#include <numbers>
+#include <string_view>
+#include <ranges>
+#include <unordered_map>
 #include <utility>
 
 namespace fs = std::filesystem;
 
-GraphConsoleAdapter::GraphConsoleAdapter(const std::string& config_path, const std::string& aliases_path): graphs_created(false), graph(nullptr), n(0) {
+namespace {
+    // Command arguments split into positional values and "--key value" options
+    struct CommandArgs {
+        std::vector<std::string> positional;
+        std::unordered_map<std::string, std::string> options;
+    };
+
+    // Options that never take a value, the token after them stays positional (BFS --l 2)
+    constexpr std::string_view boolean_flags[] = {
+        "bits", "bitset", "distances", "huge-pages", "l", "labels", "m", "merge", "populate"
+    };
+
+    CommandArgs parse_args(const std::vector<std::string>& args) {
+        CommandArgs parsed;
+        for (size_t i = 0; i < args.size(); i++) {
+            if (args[i].rfind("--", 0) == 0 && args[i].size() > 2) {
+                const std::string key = args[i].substr(2);
+                const bool has_value = i + 1 < args.size() && args[i + 1].rfind("--", 0) != 0
+                                       && std::ranges::find(boolean_flags, key) == std::end(boolean_flags);
+                parsed.options[key] = has_value ? args[++i] : "";
+            } else {
+                parsed.positional.push_back(args[i]);
+            }
+        }
+        return parsed;
+    }
+
+    // Graph storage options shared by create and import
+    ArenaOptions arena_options(const std::unordered_map<std::string, std::string>& options) {
+        ArenaOptions arena;
+        arena.huge_pages = options.contains("huge-pages");
+        arena.populate = options.contains("populate");
+        return arena;
+    }
+
+    // Commands that need no graph or lock the ones they touch themselves (the registry commands)
+    constexpr std::string_view unbound_commands[] = {
+        "cleanup", "clear", "clone", "drop", "exit", "graphs", "help", "history", "perf", "time", "use"
+    };
+
+    bool is_model(const std::string& mode) {
+        return mode == "rmat" || mode == "ba" || mode == "grid2d" || mode == "grid3d" || mode == "geometric";
+    }
+
+    // Structured generators of create, degree is the target average degree
+    Graph create_model(const std::string& mode, const int n, const double degree, const std::uint64_t seed,
+                       const int threads, const ArenaOptions arena) {
+        if (mode == "rmat") return create_graph_rmat(n, degree, seed, threads, arena);
+        if (mode == "ba") return create_graph_ba(n, std::max(1, static_cast<int>(std::lround(degree / 2))), seed, threads, arena);
+        if (mode == "geometric") {
+            // Expected degree of an interior point is n * pi * r^2
+            return create_graph_geometric(n, std::sqrt(degree / (std::numbers::pi * n)), seed, threads, arena);
+        }
+        return create_graph_grid(n, mode == "grid3d" ? 3 : 2, threads, arena);
+    }
+
+    // Parse "a:b" into a half-open range, missing ends keep their defaults, "a" means a:a+1
+    void parse_range(const std::string& text, int& begin, int& end) {
+        const size_t colon = text.find(':');
+        if (colon == std::string::npos) {
+            begin = std::stoi(text);
+            end = begin + 1;
+            return;
+        }
+        if (colon > 0) begin = std::stoi(text.substr(0, colon));
+        if (colon + 1 < text.size()) end = std::stoi(text.substr(colon + 1));
+    }
+}
+
+GraphConsoleAdapter::GraphConsoleAdapter(const std::string& config_path, const std::string& aliases_path) {
     // const std::string config_file = ("../../resources/config_files/graph_console.conf");
     // const std::string aliases_file = ("../../resources/config_files/aliases.conf");
 
@@ -58,6 +148,9 @@ GraphConsoleAdapter::GraphConsoleAdapter(const std::string& config_path, const s
     console.load_aliases(actual_aliases_path);
 
     register_graph_commands();
+    console.set_command_guard([this](const std::vector<std::string>& tokens, const bool wait) {
+        return guard_command(tokens, wait);
+    });
 }
 
 GraphConsoleAdapter::~GraphConsoleAdapter() {
@@ -68,13 +161,96 @@ void GraphConsoleAdapter::run() {
     console.run();
 }
 
+void GraphConsoleAdapter::count_allocations(const std::atomic<std::uint64_t>& counter) {
+    console.set_allocation_counter([&counter] { return counter.load(std::memory_order_relaxed); });
+}
+
+int GraphConsoleAdapter::run_batch(const std::vector<std::string>& commands) {
+    return console.run_batch(commands);
+}
+
 void GraphConsoleAdapter::cleanup() {
-    if (graph != nullptr) {
-        delete_graph(*graph, graph->n);
-        graph.reset();
+    {
+        const std::lock_guard lock(registry_mutex);
+        for (const auto& stored : graphs | std::views::values) delete_graph(*stored);
+        graphs.clear();
+        active.clear();
+    }
+    bind("");
+}
+
+// The caller holds the lock of name
+void GraphConsoleAdapter::install(const std::string& name, std::unique_ptr<Graph> created) {
+    {
+        const std::lock_guard lock(registry_mutex);
+        if (const auto it = graphs.find(name); it != graphs.end()) delete_graph(*it->second);
+        graphs[name] = std::move(created);
+        active = name;
+    }
+    bind(name);
+}
+
+bool GraphConsoleAdapter::activate(const std::string& name) {
+    const std::lock_guard lock(registry_mutex);
+    if (!graphs.contains(name)) return false;
+    active = name;
+    return true;
+}
+
+// The caller holds the lock of name
+void GraphConsoleAdapter::drop(const std::string& name) {
+    {
+        const std::lock_guard lock(registry_mutex);
+        const auto it = graphs.find(name);
+        if (it == graphs.end()) return;
+        // Storage shared with clones stays alive in them
+        delete_graph(*it->second);
+        graphs.erase(it);
+        if (name == active) active.clear();
+    }
+    if (name == bound) bind(name);
+}
+
+std::string GraphConsoleAdapter::target_name(const std::unordered_map<std::string, std::string>& options) const {
+    if (options.contains("name") && !options.at("name").empty()) return options.at("name");
+    const std::lock_guard lock(registry_mutex);
+    return active.empty() ? "main" : active;
+}
+
+std::optional<std::unique_lock<std::recursive_mutex>> GraphConsoleAdapter::guard_command(
+    const std::vector<std::string>& tokens, const bool wait) {
+    if (std::ranges::find(unbound_commands, tokens[0]) != std::end(unbound_commands)) {
+        return std::unique_lock<std::recursive_mutex>();
     }
-    n = 0;
-    graphs_created = false;
+
+    // create, load and import work on the graph they replace, the rest on the active one
+    const bool installs = tokens[0] == "create" || tokens[0] == "load" || tokens[0] == "import";
+    const std::string name = installs ? target_name(parse_args({tokens.begin() + 1, tokens.end()}).options)
+                                      : target_name({});
+    std::unique_lock lock(lock_of(name), std::defer_lock);
+    if (wait) lock.lock();
+    else if (!lock.try_lock()) return std::nullopt;
+    bind(name);
+    return lock;
+}
+
+std::recursive_mutex& GraphConsoleAdapter::lock_of(const std::string& name) {
+    const std::lock_guard lock(registry_mutex);
+    return graph_locks[name];
+}
+
+void GraphConsoleAdapter::bind(const std::string& name) {
+    const std::lock_guard lock(registry_mutex);
+    const auto it = graphs.find(name);
+    bound = name;
+    graph = it == graphs.end() ? nullptr : it->second.get();
+    n = graph == nullptr ? 0 : graph->n;
+    graphs_created = graph != nullptr;
+}
+
+void GraphConsoleAdapter::report_busy(const std::string& name) const {
+    console.out() << "Busy: a background job is using '" << name << "', use 'wait' or 'cancel <id>'" << std::endl;
+    console.fail();
 }
 
 
@@ -109,13 +285,21 @@ void GraphConsoleAdapter::register_graph_commands() {
     console.register_command("create",
             [this](const std::vector<std::string>& args) { this->cmd_create(args); },
             "Create a new graph system",
-            {"vertices", "edge_probability", "loop_probability"},
-            "create <n> <edgeProb> <loopProb>"
+            {"vertices", "edge_probability", "loop_probability",
+             "--mode (dense || sparse || rmat || ba || grid2d || grid3d || geometric)",
+             "--degree (average degree of rmat, ba and geometric, default 16)", "--seed (0 = random)",
+             "--threads (parallel generator, 0 = all cores)", "--huge-pages (THP-backed storage)",
+             "--populate (pre-fault storage)", "--name (graph to replace or add, default the active one)"},
+            "create <n> <edgeProb> <loopProb> [--mode dense|sparse|rmat|ba|grid2d|grid3d|geometric] [--degree d] "
+            "[--seed s] [--threads t] [--huge-pages] [--populate] [--name g]"
         );
 
     console.register_command("print",
-        [this](const std::vector<std::string>&) { this->cmd_print(); },
-        "Print current graph system"
+        [this](const std::vector<std::string>& args) { this->cmd_print(args); },
+        "Print current graph system in stored ids (the relabeled layout after reorder)",
+        {"--rows a:b", "--cols c:d", "--bits (one character per cell)", "--list-range a:b",
+         "--density <file.pgm|file.pbm>", "--size (density map side, default 512)"},
+        "print [--rows a:b] [--cols c:d] [--bits] [--list-range a:b] [--density file] [--size s]"
     );
 
     console.register_command("clear",
@@ -125,7 +309,7 @@ void GraphConsoleAdapter::register_graph_commands() {
 
     console.register_command("cleanup",
         [this](const std::vector<std::string>&) { this->cmd_cleanup(); },
-        "Cleanup graph system and free memory"
+        "Cleanup graph system (every named graph) and free memory"
     );
 
     console.register_command("help",
@@ -148,51 +332,275 @@ void GraphConsoleAdapter::register_graph_commands() {
     console.register_command("DFS",
         [this](const std::vector<std::string>& args) { this->cmd_traversal(args); },
         "DFS traversal",
-        {"vertex", " --representation (m || l)", "--method (r || i)"},
+        {"vertex", " --representation (m || l || c)", "--method (r || i)"},
         "DFS <v> <--representation> <--method>"
     );
+
+    console.register_command("BFS",
+        [this](const std::vector<std::string>& args) { this->cmd_bfs(args); },
+        "Direction-optimizing parallel BFS",
+        {"vertex", "--m || --l (representation)", "--threads (0 = all cores)", "--distances (print level per vertex)"},
+        "BFS <v> [--m|--l] [--threads t] [--distances]"
+    );
+
+    console.register_command("bfs-multi",
+        [this](const std::vector<std::string>& args) { this->cmd_bfs_multi(args); },
+        "Bit-parallel BFS from up to 512 sources at once",
+        {"vertices (sources)", "--threads (0 = all cores)", "--distances (print per-source level per vertex)"},
+        "bfs-multi <v1> <v2> ... [--threads t] [--distances]"
+    );
+
+    console.register_command("components",
+        [this](const std::vector<std::string>& args) { this->cmd_components(args); },
+        "Connected components with size histogram",
+        {"--threads (0 = all cores)", "--labels (print component id per vertex)"},
+        "components [--threads t] [--labels]"
+    );
+
+    console.register_command("save",
+        [this](const std::vector<std::string>& args) { this->cmd_save(args); },
+        "Save the graph as a binary snapshot",
+        {"file"},
+        "save <file>"
+    );
+
+    console.register_command("load",
+        [this](const std::vector<std::string>& args) { this->cmd_load(args); },
+        "Load a binary snapshot by mapping it in place",
+        {"file", "--name (graph to replace or add, default the active one)"},
+        "load <file> [--name g]"
+    );
+
+    console.register_command("import",
+        [this](const std::vector<std::string>& args) { this->cmd_import(args); },
+        "Import a graph from a text edge list (u v per line)",
+        {"file", "--name (graph to replace or add, default the active one)", "--threads (0 = all cores)",
+         "--huge-pages (THP-backed storage)", "--populate (pre-fault storage)"},
+        "import <file> [--name g] [--threads t] [--huge-pages] [--populate]"
+    );
+
+    console.register_command("stats",
+        [this](const std::vector<std::string>& args) { this->cmd_stats(args); },
+        "Show vertex/edge counts, memory and build time per representation",
+        {"--threads (0 = all cores)"},
+        "stats [--threads t]"
+    );
+
+    console.register_command("add-edge",
+        [this](const std::vector<std::string>& args) { this->cmd_add_edge(args); },
+        "Add an undirected edge in place",
+        {"u", "v"},
+        "add-edge <u> <v>"
+    );
+
+    console.register_command("remove-edge",
+        [this](const std::vector<std::string>& args) { this->cmd_remove_edge(args); },
+        "Remove an undirected edge in place",
+        {"u", "v"},
+        "remove-edge <u> <v>"
+    );
+
+    console.register_command("add-vertex",
+        [this](const std::vector<std::string>&) { this->cmd_add_vertex(); },
+        "Append an isolated vertex",
+        {},
+        "add-vertex"
+    );
+
+    console.register_command("connected",
+        [this](const std::vector<std::string>& args) { this->cmd_connected(args); },
+        "Check whether two vertices are in one component",
+        {"u", "v", "--threads (rebuild after deletions, 0 = all cores)"},
+        "connected <u> <v> [--threads t]"
+    );
+
+    console.register_command("profile",
+        [this](const std::vector<std::string>& args) { this->cmd_profile(args); },
+        "Run a command under hardware performance counters",
+        {"command", "args..."},
+        "profile <command> [args...]"
+    );
+
+    console.register_command("reorder",
+        [this](const std::vector<std::string>& args) { this->cmd_reorder(args); },
+        "Relabel vertices for locality, commands keep the original ids (print shows the new layout)",
+        {"rcm|degree|bfs", "--threads (0 = all cores)"},
+        "reorder <rcm|degree|bfs> [--threads t]"
+    );
+
+    console.register_command("metrics",
+        [this](const std::vector<std::string>& args) { this->cmd_metrics(args); },
+        "Degree statistics, triangle count and clustering coefficient",
+        {"--threads (0 = all cores)", "--bitset (count on the matrix)", "--merge (count on sorted lists)"},
+        "metrics [--threads t] [--bitset|--merge]"
+    );
+
+    console.register_command("graphs",
+        [this](const std::vector<std::string>&) { this->cmd_graphs(); },
+        "List named graphs, the active one is marked with *",
+        {},
+        "graphs"
+    );
+
+    console.register_command("use",
+        [this](const std::vector<std::string>& args) { this->cmd_use(args); },
+        "Make a named graph the one commands work on",
+        {"name"},
+        "use <name>"
+    );
+
+    console.register_command("clone",
+        [this](const std::vector<std::string>& args) { this->cmd_clone(args); },
+        "Copy a graph under a new name, storage is shared until either is modified",
+        {"source", "name"},
+        "clone <source> <name>"
+    );
+
+    console.register_command("drop",
+        [this](const std::vector<std::string>& args) { this->cmd_drop(args); },
+        "Delete a named graph",
+        {"name"},
+        "drop <name>"
+    );
 }
 
 void GraphConsoleAdapter::cmd_create(const std::vector<std::string>& args) {
     try {
-        const int new_n = args.empty() ? 5 : std::stoi(args[0]);
-        const double new_edge_prob = args.size() > 1 ?  std::stod(args[1]) : 0.5;
-        const double new_loop_prob = args.size() > 2 ?  std::stod(args[2]) : 0.3;
+        const auto [positional, options] = parse_args(args);
+        const int new_n = positional.empty() ? 5 : std::stoi(positional[0]);
+        const double new_edge_prob = positional.size() > 1 ?  std::stod(positional[1]) : 0.5;
+        const double new_loop_prob = positional.size() > 2 ?  std::stod(positional[2]) : 0.3;
+        const std::string mode = options.contains("mode") ? options.at("mode") : "dense";
+        const bool model = is_model(mode);
+        const double degree = options.contains("degree") ? std::stod(options.at("degree")) : 16.0;
+        const std::uint64_t seed = options.contains("seed") ? std::stoull(options.at("seed")) : 0;
+        const bool parallel = options.contains("threads");
+        const int threads = parallel ? std::stoi(options.at("threads")) : 1;
+        const ArenaOptions arena = arena_options(options);
 
 
         if (new_n <= 0) {
-            std::cout << "Invalid number of vertices." << std::endl;
+            console.out() << "Invalid number of vertices." << std::endl;
+            console.fail();
             return;
         }
         if (new_edge_prob <= 0 || new_edge_prob > 1 || new_loop_prob <= 0 || new_loop_prob > 1) {
-            std::cout << "Probabilities must be between 0 and 1" << std::endl;
+            console.out() << "Probabilities must be between 0 and 1" << std::endl;
+            console.fail();
+            return;
+        }
+        if (mode != "dense" && mode != "sparse" && !model) {
+            console.out() << "Invalid mode." << std::endl;
+            console.fail();
+            return;
+        }
+        if (degree <= 0) {
+            console.out() << "Degree must be positive." << std::endl;
+            console.fail();
             return;
         }
 
-        cleanup();
+        if (threads < 0) {
+            console.out() << "Invalid number of threads." << std::endl;
+            console.fail();
+            return;
+        }
+
+        // The graph being replaced (bound by guard_command) stays until the new one is complete,
+        // so a failed or cancelled create keeps it
+        const std::string name = bound;
 
-        n = new_n;
-        graph = std::make_unique<Graph>(create_graph(n, new_edge_prob, new_loop_prob, 0));
-        graphs_created = true;
+        std::unique_ptr<Graph> created;
+        if (model) {
+            // Models are always parallel, all cores unless --threads is given
+            const std::uint64_t actual_seed = seed == 0 ? time_seed() : seed;
+            created = std::make_unique<Graph>(create_model(mode, new_n, degree, actual_seed, parallel ? threads : 0, arena));
+            console.out() << "Generator: " << mode << ", " << resolve_threads(parallel ? threads : 0) << " threads, seed "
+                          << actual_seed << std::endl;
+        } else if (parallel) {
+            // Resolve the seed here so the run can be reproduced
+            const std::uint64_t actual_seed = seed == 0 ? time_seed() : seed;
+            created = std::make_unique<Graph>(create_graph_parallel(new_n, new_edge_prob, new_loop_prob, actual_seed,
+                                                                    threads, mode == "sparse", arena));
+            console.out() << "Parallel generator: " << resolve_threads(threads) << " threads, seed " << actual_seed << std::endl;
+        } else if (mode == "sparse") {
+            created = std::make_unique<Graph>(create_graph_sparse(new_n, new_edge_prob, new_loop_prob, seed, arena));
+        } else {
+            created = std::make_unique<Graph>(create_graph(new_n, new_edge_prob, new_loop_prob,
+                                                           static_cast<unsigned int>(seed), arena));
+        }
+        install(name, std::move(created));
 
-        std::cout << "Created two graphs with " << n << " vertices" << std::endl;
-        std::cout << "  Edge probability: " << new_edge_prob << ", Loop probability: " << new_loop_prob << std::endl;
+        console.out() << "Created two graphs with " << n << " vertices as '" << name << "'" << std::endl;
+        if (model) {
+            console.out() << "  Edges: " << graph->csr.entries() / 2 << ", average degree "
+                          << static_cast<double>(graph->csr.entries()) / n << std::endl;
+        }
+        else console.out() << "  Edge probability: " << new_edge_prob << ", Loop probability: " << new_loop_prob << std::endl;
+        console.out() << "  Mode: " << mode << ", " << (graph->has_matrix() ? "adjacency matrix" : "CSR") << " built in "
+                      << graph->build_ms.generate << " ms, other representations are built on first use" << std::endl;
 
+    } catch (const Cancelled&) {
+        // Stopped by 'cancel' while running as a job, the graphs are unchanged
+        console.out() << "Create cancelled" << std::endl;
+        console.fail();
     } catch (const std::exception& e) {
-        std::cout << "Error creating graphs: " << e.what() << std::endl;
-        std::cout << "Usage: create <vertices> <edge_probability> <loop_probability>" << std::endl;
+        console.out() << "Error creating graphs: " << e.what() << std::endl;
+        console.out() << "Usage: create <vertices> <edge_probability> <loop_probability>" << std::endl;
+        console.fail();
     }
 }
 
-void GraphConsoleAdapter::cmd_print() const {
+void GraphConsoleAdapter::cmd_print(const std::vector<std::string>& args) const {
     if (!graphs_created) {
-        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
         return;
     }
 
-    std::cout << "=== GRAPH 3 ===" << std::endl;
-    print_matrix(graph->adj_matrix, graph->n, graph->n, "Adjacency Matrix 3");
-    print_list(graph->adj_list, "Adjacency List 3");
+    try {
+        const auto options = parse_args(args).options;
+
+        if (options.contains("density")) {
+            const std::string& path = options.at("density");
+            const int size = options.contains("size") ? std::stoi(options.at("size")) : 512;
+            if (export_density_map(ensure_csr(*graph), path, size)) {
+                console.out() << "Density map written to " << path << std::endl;
+            } else {
+                console.out() << "Failed to write density map (expected .pgm or .pbm file)" << std::endl;
+                console.fail();
+            }
+            return;
+        }
+
+        // Windowed output: --rows/--cols/--bits select the matrix, --list-range the list
+        const bool matrix_window = options.contains("rows") || options.contains("cols") || options.contains("bits");
+        const bool list_window = options.contains("list-range");
+
+        console.out() << "=== GRAPH 3 ===" << std::endl;
+        // The layout is the point of printing a reordered graph, so rows and columns keep their stored ids
+        if (!graph->ids.identity()) console.out() << "Reordered graph: rows and neighbours use stored ids" << std::endl;
+        if (matrix_window || !list_window) {
+            RenderWindow window;
+            if (options.contains("rows")) parse_range(options.at("rows"), window.row_begin, window.row_end);
+            if (options.contains("cols")) parse_range(options.at("cols"), window.col_begin, window.col_end);
+            const MatrixStyle style = options.contains("bits") ? MatrixStyle::Bits : MatrixStyle::Table;
+
+            if (graph->n > max_matrix_vertices) {
+                console.out() << "Adjacency matrix not available (more than " << max_matrix_vertices << " vertices)" << std::endl;
+            } else {
+                render_matrix(ensure_matrix(*graph), "Adjacency Matrix 3", window, style);
+            }
+        }
+        if (list_window || !matrix_window) {
+            int begin = 0, end = -1;
+            if (list_window) parse_range(options.at("list-range"), begin, end);
+            render_list(ensure_list(*graph), "Adjacency List 3", begin, end);
+        }
+    } catch (const std::exception& e) {
+        console.out() << "Error print: " << e.what() << std::endl;
+        console.fail();
+    }
 }
 
 void GraphConsoleAdapter::cmd_clear() {
@@ -200,12 +608,25 @@ void GraphConsoleAdapter::cmd_clear() {
 }
 
 void GraphConsoleAdapter::cmd_cleanup() {
-    cleanup();
-    std::cout << "Graph system cleaned up" << std::endl;
+    std::vector<std::string> names;
+    {
+        const std::lock_guard lock(registry_mutex);
+        for (const auto& name : graphs | std::views::keys) names.push_back(name);
+    }
+    // Every graph or none, a graph a job adds meanwhile stays
+    std::vector<std::unique_lock<std::recursive_mutex>> held;
+    for (const auto& name : names) {
+        if (!held.emplace_back(lock_of(name), std::try_to_lock).owns_lock()) {
+            report_busy(name);
+            return;
+        }
+    }
+    for (const auto& name : names) drop(name);
+    console.out() << "Graph system cleaned up" << std::endl;
 }
 
 void GraphConsoleAdapter::cmd_exit() {
-    cleanup();
+    // The graphs are freed by the destructor, after jobs that may still use them
     console.stop();
 }
 
@@ -223,44 +644,697 @@ void GraphConsoleAdapter::cmd_history() {
 
 void GraphConsoleAdapter::cmd_traversal(const std::vector<std::string> &args) const {
     if (!graphs_created) {
-        std::cout << "No graphs created. Use 'create' command first." << std::endl;
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
         return;
     }
 
     try {
-        const int v = args.empty() ? 0 : std::stoi(args[0]);
+        // Vertex ids are the original ones, also after a reorder
+        const int v = graph->ids.to_current(args.empty() ? 0 : std::stoi(args[0]));
         const std::string rep = args.size() > 1 ? args[1] : "--m";
         const std::string method = args.size() > 2 ? args[2] : "--r";
 
         if (v >= graph->n || v < 0) {
-            std::cout << "Invalid number of vertices." << std::endl;
+            console.out() << "Invalid number of vertices." << std::endl;
+            console.fail();
             return;
         }
-        if (args[1] == "all") {
+        // Traversals only fill the result, printing happens afterwards in one pass
+        Traversal& result = traversal;
+        const auto report = [&] {
+            graph->ids.restore(result.order);
+            print_traversal(result);
+        };
+        if (rep == "all") {
             cmd_print();
-            std::cout << "===Recursive operations===" << std::endl;
-            std::cout << "Matrix traversal:" << std::endl;
-            prep(*graph, v, true);
-            std::cout << "List traversal:" << std::endl;
-            prep_list(*graph, v, true);
-            std::cout << "===Iterative operations===" << std::endl;
-            std::cout << "Matrix traversal:" << std::endl;
-            prep(*graph, v, false);
-            std::cout << "List traversal:" << std::endl;
-            prep_list(*graph, v, false);
+            ensure_matrix(*graph);
+            ensure_list(*graph);
+            ensure_csr(*graph);
+            for (const bool recursive : {true, false}) {
+                console.out() << (recursive ? "===Recursive operations===" : "===Iterative operations===") << std::endl;
+                console.out() << "Matrix traversal:" << std::endl;
+                prep(*graph, v, recursive, result, workspace);
+                report();
+                console.out() << "List traversal:" << std::endl;
+                prep_list(*graph, v, recursive, result, workspace);
+                report();
+                console.out() << "CSR traversal:" << std::endl;
+                prep_csr(*graph, v, recursive, result, workspace);
+                report();
+            }
             return;
         }
-        if (rep != "--l" && rep != "--m") {
-            std::cout << "Invalid representation." << std::endl;
+        if (rep != "--l" && rep != "--m" && rep != "--c") {
+            console.out() << "Invalid representation." << std::endl;
+            console.fail();
             return;
         }
         if (method != "--r"  && method != "--i") {
-            std::cout << "Invalid method." << std::endl;
+            console.out() << "Invalid method." << std::endl;
+            console.fail();
             return;
         }
+        // The representation is materialized on first use
         const bool m = method == "--r";
-        rep == "--m" ? prep(*graph, v, m) : prep_list(*graph, v, m);
+        if (rep == "--m") {
+            ensure_matrix(*graph);
+            prep(*graph, v, m, result, workspace);
+        } else if (rep == "--l") {
+            ensure_list(*graph);
+            prep_list(*graph, v, m, result, workspace);
+        } else {
+            ensure_csr(*graph);
+            prep_csr(*graph, v, m, result, workspace);
+        }
+        report();
+    } catch (const std::exception& e) {
+        console.out() << "Error DFS: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_components(const std::vector<std::string>& args) const {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto options = parse_args(args).options;
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+
+        ensure_list(*graph, threads);
+        const auto start = std::chrono::steady_clock::now();
+        const Components components = connected_components(*graph, threads);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        int largest = 0;
+        for (const int size : components.size) largest = std::max(largest, size);
+
+        console.out() << "Components: " << components.count() << ", largest: " << largest
+                      << " vertices (" << elapsed.count() << " ms)" << std::endl;
+        console.out() << "Size histogram:" << std::endl;
+        const auto histogram = component_size_histogram(components);
+        for (size_t k = 0; k < histogram.size(); k++) {
+            if (histogram[k] == 0) continue;
+            console.out() << "  [" << (1LL << k) << ", " << (1LL << (k + 1)) << "): " << histogram[k] << std::endl;
+        }
+
+        if (options.contains("labels")) {
+            OutputBuffer out(console.out());
+            for (int v = 0; v < graph->n; v++) {
+                out.put_int(v);
+                out.put(": ");
+                out.put_int(components.label[graph->ids.to_current(v)]);
+                out.put('\n');
+            }
+        }
+    } catch (const std::exception& e) {
+        console.out() << "Error components: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_bfs(const std::vector<std::string>& args) const {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto [positional, options] = parse_args(args);
+        const int source = positional.empty() ? 0 : std::stoi(positional[0]);
+        const int v = graph->ids.to_current(source);
+        const bool use_matrix = !options.contains("l");
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+
+        if (v >= graph->n || v < 0) {
+            console.out() << "Invalid number of vertices." << std::endl;
+            console.fail();
+            return;
+        }
+        if (use_matrix) ensure_matrix(*graph, threads);
+        else ensure_list(*graph, threads);
+
+        BFSResult result;
+        const auto start = std::chrono::steady_clock::now();
+        use_matrix ? BFS(v, *graph, result, threads) : BFS_list(v, *graph, result, threads);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        long long reached = 0;
+        for (const int size : result.level_sizes) reached += size;
+
+        console.out() << (use_matrix ? "Matrix" : "List") << " BFS from " << source << ": reached " << reached
+                      << " vertices in " << result.level_sizes.size() << " levels (" << elapsed.count() << " ms)" << std::endl;
+        console.out() << "  Steps: " << result.top_down_steps << " top-down, " << result.bottom_up_steps
+                      << " bottom-up, " << result.edges_checked << (use_matrix ? " row words" : " edges") << " checked" << std::endl;
+        console.out() << "  Level sizes:";
+        for (const int size : result.level_sizes) console.out() << " " << size;
+        console.out() << std::endl;
+
+        if (options.contains("distances")) {
+            OutputBuffer out(console.out());
+            for (int u = 0; u < graph->n; u++) {
+                out.put_int(u);
+                out.put(": ");
+                out.put_int(result.distance[graph->ids.to_current(u)]);
+                out.put('\n');
+            }
+        }
+    } catch (const std::exception& e) {
+        console.out() << "Error BFS: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_bfs_multi(const std::vector<std::string>& args) const {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto [positional, options] = parse_args(args);
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+        const bool show_distances = options.contains("distances");
+
+        if (positional.empty()) {
+            console.out() << "Usage: bfs-multi <v1> <v2> ... [--threads t] [--distances]" << std::endl;
+            console.fail();
+            return;
+        }
+        std::vector<int> sources;
+        sources.reserve(positional.size());
+        for (const auto& value : positional) {
+            const int v = graph->ids.to_current(std::stoi(value));
+            if (v >= graph->n || v < 0) {
+                console.out() << "Invalid number of vertices." << std::endl;
+                console.fail();
+                return;
+            }
+            sources.push_back(v);
+        }
+        if (sources.size() > static_cast<std::size_t>(max_multi_sources)) {
+            console.out() << "At most " << max_multi_sources << " sources per call." << std::endl;
+            console.fail();
+            return;
+        }
+
+        ensure_list(*graph, threads);
+        MultiBFSResult result;
+        const auto start = std::chrono::steady_clock::now();
+        BFS_multi(sources, *graph, result, threads, show_distances);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        console.out() << "Multi-source BFS from " << sources.size() << " sources: " << result.levels
+                      << " levels (" << elapsed.count() << " ms)" << std::endl;
+        OutputBuffer out(console.out());
+        for (std::size_t i = 0; i < sources.size(); i++) {
+            const double average = result.reached[i] > 1
+                ? static_cast<double>(result.distance_sum[i]) / static_cast<double>(result.reached[i] - 1) : 0.0;
+            out.put("  ");
+            out.put_int(graph->ids.to_original(sources[i]));
+            out.put(": reached ");
+            out.put_int(result.reached[i]);
+            out.put(", eccentricity ");
+            out.put_int(result.eccentricity[i]);
+            out.put(", avg distance ");
+            char text[32];
+            const auto [end, ec] = std::to_chars(text, text + sizeof(text), average, std::chars_format::fixed, 3);
+            out.put(std::string_view(text, end - text));
+            out.put('\n');
+        }
+
+        if (show_distances) {
+            for (int u = 0; u < graph->n; u++) {
+                out.put_int(u);
+                out.put(":");
+                for (std::size_t i = 0; i < sources.size(); i++) {
+                    out.put(' ');
+                    out.put_int(result.distance[i * graph->n + graph->ids.to_current(u)]);
+                }
+                out.put('\n');
+            }
+        }
+    } catch (const std::exception& e) {
+        console.out() << "Error bfs-multi: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_save(const std::vector<std::string>& args) const {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+    if (args.empty()) {
+        console.out() << "Usage: save <file>" << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto start = std::chrono::steady_clock::now();
+        ensure_csr(*graph);
+        const std::uint64_t bytes = save_snapshot(*graph, args[0]);
+        const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        console.out() << "Saved " << n << " vertices to " << args[0] << " (" << bytes << " bytes, "
+                      << elapsed.count() << " ms)" << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error save: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_load(const std::vector<std::string>& args) {
+    const auto [positional, options] = parse_args(args);
+    if (positional.empty()) {
+        console.out() << "Usage: load <file> [--name g]" << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        // Load before replacing so a bad file keeps the current graph
+        auto loaded = std::make_unique<Graph>(load_snapshot(positional[0]));
+        install(bound, std::move(loaded));
+
+        console.out() << "Loaded " << n << " vertices from " << positional[0] << " (" << graph->build_ms.generate << " ms)" << std::endl;
+        console.out() << "  Adjacency entries: " << graph->csr.entries()
+                      << (graph->adj_matrix.empty() ? ", no adjacency matrix" : ", adjacency matrix mapped") << std::endl;
+        if (!graph->ids.identity()) console.out() << "  Reordered graph, original vertex ids restored" << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error load: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_import(const std::vector<std::string>& args) {
+    try {
+        const auto [positional, options] = parse_args(args);
+        if (positional.empty()) {
+            console.out() << "Usage: import <file> [--name g] [--threads t] [--huge-pages] [--populate]" << std::endl;
+            console.fail();
+            return;
+        }
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+
+        ImportStats stats;
+        const auto start = std::chrono::steady_clock::now();
+        auto imported = std::make_unique<Graph>(import_edge_list(positional[0], stats, threads, arena_options(options)));
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+
+        install(bound, std::move(imported));
+
+        console.out() << "Imported " << n << " vertices from " << positional[0] << " (" << elapsed.count() * 1000.0
+                      << " ms, " << static_cast<double>(stats.bytes) / 1e6 / elapsed.count() << " MB/s)" << std::endl;
+        console.out() << "  Edge lines: " << stats.edges << ", duplicates dropped: " << stats.duplicates
+                      << ", self-loops: " << stats.loops << ", adjacency entries: " << graph->csr.entries() << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error import: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_stats(const std::vector<std::string>& args) const {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto options = parse_args(args).options;
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+        const GraphStats stats = graph_stats(*graph, threads);
+        const BuildTimes& times = graph->build_ms;
+
+        console.out() << "Vertices: " << stats.vertices << ", edges: " << stats.edges
+                      << ", self-loops: " << stats.self_loops << std::endl;
+        console.out() << "Generated in " << times.generate << " ms" << std::endl;
+
+        const auto row = [this](const char* name, const bool built, const std::size_t bytes, const double ms) {
+            console.out() << "  " << std::left << std::setw(8) << name << std::right;
+            if (!built) {
+                console.out() << "not built" << std::endl;
+                return;
+            }
+            console.out() << std::setw(14) << bytes << " bytes (" << std::fixed << std::setprecision(2)
+                          << static_cast<double>(bytes) / (1 << 20) << " MiB)";
+            if (ms > 0) console.out() << ", converted in " << ms << " ms";
+            console.out() << std::defaultfloat << std::setprecision(6) << std::endl;
+        };
+        row("matrix", graph->has_matrix(), stats.matrix_bytes, times.matrix);
+        row("list", graph->has_list(), stats.list_bytes, times.list);
+        row("csr", graph->has_csr(), stats.csr_bytes, times.csr);
+        console.out() << "Arena: " << graph->arena->used_bytes() << " of " << graph->arena->mapped_bytes()
+                      << " mapped bytes in use, " << graph->arena->block_count() << " blocks" << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error stats: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_add_edge(const std::vector<std::string>& args) {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+    if (args.size() < 2) {
+        console.out() << "Usage: add-edge <u> <v>" << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const int u = std::stoi(args[0]);
+        const int v = std::stoi(args[1]);
+        if (add_edge(*graph, graph->ids.to_current(u), graph->ids.to_current(v))) console.out() << "Added edge " << u << " - " << v << std::endl;
+        else console.out() << "Edge " << u << " - " << v << " already exists" << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error add-edge: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_remove_edge(const std::vector<std::string>& args) {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+    if (args.size() < 2) {
+        console.out() << "Usage: remove-edge <u> <v>" << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const int u = std::stoi(args[0]);
+        const int v = std::stoi(args[1]);
+        if (remove_edge(*graph, graph->ids.to_current(u), graph->ids.to_current(v))) console.out() << "Removed edge " << u << " - " << v << std::endl;
+        else console.out() << "No edge " << u << " - " << v << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error remove-edge: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_add_vertex() {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const int v = add_vertex(*graph);
+        n = graph->n;
+        console.out() << "Added vertex " << v << ", graph has " << n << " vertices" << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error add-vertex: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_connected(const std::vector<std::string>& args) {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto [positional, options] = parse_args(args);
+        if (positional.size() < 2) {
+            console.out() << "Usage: connected <u> <v> [--threads t]" << std::endl;
+            console.fail();
+            return;
+        }
+        const int u = std::stoi(positional[0]);
+        const int v = std::stoi(positional[1]);
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+
+        const bool rebuild = graph->connectivity.empty();
+        const auto start = std::chrono::steady_clock::now();
+        const bool same = connected(*graph, graph->ids.to_current(u), graph->ids.to_current(v), threads);
+        const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+        console.out() << u << " and " << v << (same ? " are" : " are not") << " connected (" << elapsed.count() << " us"
+                      << (rebuild ? ", components rebuilt" : "") << ")" << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error connected: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_profile(const std::vector<std::string>& args) {
+    if (args.empty()) {
+        console.out() << "Usage: profile <command> [args...]" << std::endl;
+        console.fail();
+        return;
+    }
+
+    std::string command;
+    for (const auto& arg : args) command += arg + " ";
+    command.pop_back();
+
+    PerfCounters counters;
+    const auto start = std::chrono::steady_clock::now();
+    counters.start();
+    const bool ok = console.execute(command);
+    counters.stop();
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+    // Normalize by the graph the command left behind (create builds it, traversals read it)
+    const long long edges = graphs_created ? graph_stats(*graph).edges : 0;
+
+    console.out() << "Profile of '" << command << "' (" << elapsed.count() << " ms" << (ok ? "" : ", command failed") << ")"
+                  << std::endl;
+    if (!counters.any_available()) {
+        console.out() << "  Hardware counters unavailable (" << counters.unavailable_reason() << ")" << std::endl;
+    }
+    const auto cycles = counters.value(HwEvent::Cycles);
+    const auto instructions = counters.value(HwEvent::Instructions);
+    for (int e = 0; e < static_cast<int>(HwEvent::Count); e++) {
+        const auto event = static_cast<HwEvent>(e);
+        const auto value = counters.value(event);
+        if (!value) continue;
+        console.out() << "  " << std::left << std::setw(14) << PerfCounters::name(event) << std::right << std::setw(16) << *value;
+        if (event == HwEvent::Instructions && cycles && *cycles > 0) {
+            console.out() << "  IPC " << static_cast<double>(*value) / static_cast<double>(*cycles);
+        } else if (event != HwEvent::Cycles && edges > 0) {
+            console.out() << "  per edge " << static_cast<double>(*value) / static_cast<double>(edges);
+        }
+        if (event == HwEvent::BranchMisses && instructions && *instructions > 0) {
+            console.out() << ", per 1k instructions " << 1000.0 * static_cast<double>(*value) / static_cast<double>(*instructions);
+        }
+        if (counters.multiplexed(event)) console.out() << " (multiplexed, scaled)";
+        console.out() << std::endl;
+    }
+    const SoftCounters& soft = counters.soft();
+    console.out() << "  Page faults: " << soft.minor_faults << " minor, " << soft.major_faults << " major; context switches: "
+                  << soft.context_switches << std::endl;
+    if (edges > 0) console.out() << "  Edges: " << edges << std::endl;
+}
+
+void GraphConsoleAdapter::cmd_reorder(const std::vector<std::string>& args) {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto [positional, options] = parse_args(args);
+        const std::string name = positional.empty() ? "" : positional[0];
+        VertexOrder order;
+        if (name == "rcm") order = VertexOrder::Rcm;
+        else if (name == "degree") order = VertexOrder::Degree;
+        else if (name == "bfs") order = VertexOrder::Bfs;
+        else {
+            console.out() << "Usage: reorder <rcm|degree|bfs> [--threads t]" << std::endl;
+            console.fail();
+            return;
+        }
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+
+        const ReorderStats stats = reorder_graph(*graph, order, threads);
+        console.out() << "Reordered " << graph->n << " vertices (" << name << "): permutation " << stats.order_ms
+                      << " ms, relabel " << stats.relabel_ms << " ms" << std::endl;
+        console.out() << "  Mean neighbour gap: " << stats.gap_before << " -> " << stats.gap_after
+                      << ", bandwidth: " << stats.bandwidth_before << " -> " << stats.bandwidth_after << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error reorder: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_metrics(const std::vector<std::string>& args) const {
+    if (!graphs_created) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        const auto options = parse_args(args).options;
+        const int threads = options.contains("threads") ? std::stoi(options.at("threads")) : 0;
+        if (options.contains("bitset") && options.contains("merge")) {
+            console.out() << "Usage: metrics [--threads t] [--bitset|--merge]" << std::endl;
+            console.fail();
+            return;
+        }
+        const TriangleMethod method = options.contains("bitset") ? TriangleMethod::Bitset
+                                    : options.contains("merge") ? TriangleMethod::Merge : TriangleMethod::Auto;
+
+        const GraphMetrics metrics = graph_metrics(*graph, threads, method);
+        console.out() << "Vertices: " << metrics.vertices << ", edges: " << metrics.edges
+                      << ", self-loops: " << metrics.self_loops << std::endl;
+        console.out() << "Degree: max " << metrics.max_degree << ", average " << metrics.average_degree
+                      << ", isolated " << metrics.isolated << std::endl;
+        console.out() << "Degree histogram:" << std::endl;
+        for (size_t k = 0; k < metrics.degree_histogram.size(); k++) {
+            if (metrics.degree_histogram[k] == 0) continue;
+            console.out() << "  [" << (1LL << k) << ", " << (1LL << (k + 1)) << "): " << metrics.degree_histogram[k] << std::endl;
+        }
+        console.out() << "Triangles: " << metrics.triangles << " (" << (metrics.bitset ? "bitset" : "merge") << ", "
+                      << metrics.triangle_ms << " ms)" << std::endl;
+        console.out() << "Clustering coefficient: " << metrics.clustering() << std::endl;
+    } catch (const std::exception& e) {
+        console.out() << "Error metrics: " << e.what() << std::endl;
+        console.fail();
+    }
+}
+
+void GraphConsoleAdapter::cmd_graphs() {
+    std::vector<std::string> names;
+    std::string current;
+    {
+        const std::lock_guard lock(registry_mutex);
+        for (const auto& name : graphs | std::views::keys) names.push_back(name);
+        current = active;
+    }
+    if (names.empty()) {
+        console.out() << "No graphs created. Use 'create' command first." << std::endl;
+        return;
+    }
+
+    for (const auto& name : names) {
+        console.out() << (name == current ? "* " : "  ") << std::left << std::setw(12) << name << std::right;
+        // A graph a job works on may be changing, it is only named
+        const std::unique_lock graph_lock(lock_of(name), std::try_to_lock);
+        if (!graph_lock.owns_lock()) {
+            console.out() << "  busy (background job)" << std::endl;
+            continue;
+        }
+        const Graph* stored = nullptr;
+        {
+            const std::lock_guard lock(registry_mutex);
+            if (const auto it = graphs.find(name); it != graphs.end()) stored = it->second.get();
+        }
+        if (stored == nullptr) {
+            console.out() << "  dropped" << std::endl;
+            continue;
+        }
+        const std::size_t bytes = stored->adj_matrix.bytes() + stored->adj_list.bytes() + stored->csr.bytes();
+        console.out() << std::setw(10) << stored->n << " vertices  " << std::fixed << std::setprecision(2)
+                      << static_cast<double>(bytes) / (1 << 20) << " MiB" << std::defaultfloat << std::setprecision(6);
+        if (stored->sharers() > 0) console.out() << ", storage shared with " << stored->sharers() << " other(s)";
+        console.out() << std::endl;
+    }
+}
+
+void GraphConsoleAdapter::cmd_use(const std::vector<std::string>& args) {
+    if (args.size() != 1) {
+        console.out() << "Usage: use <name>" << std::endl;
+        console.fail();
+        return;
+    }
+    if (!activate(args[0])) {
+        console.out() << "No graph named '" << args[0] << "'" << std::endl;
+        console.fail();
+        return;
+    }
+
+    // The next command binds it, the vertex count is only read when no job is changing it
+    console.out() << "Using '" << args[0] << "'";
+    if (const std::unique_lock graph_lock(lock_of(args[0]), std::try_to_lock); graph_lock.owns_lock()) {
+        bind(args[0]);
+        console.out() << " (" << n << " vertices)" << std::endl;
+    } else {
+        console.out() << ", a background job is using it" << std::endl;
+    }
+}
+
+void GraphConsoleAdapter::cmd_clone(const std::vector<std::string>& args) {
+    if (args.size() != 2) {
+        console.out() << "Usage: clone <source> <name>" << std::endl;
+        console.fail();
+        return;
+    }
+    const std::unique_lock source_lock(lock_of(args[0]), std::try_to_lock);
+    if (!source_lock.owns_lock()) {
+        report_busy(args[0]);
+        return;
+    }
+    const std::unique_lock target_lock(lock_of(args[1]), std::try_to_lock);
+    if (!target_lock.owns_lock()) {
+        report_busy(args[1]);
+        return;
+    }
+
+    const std::lock_guard lock(registry_mutex);
+    const auto source = graphs.find(args[0]);
+    if (source == graphs.end()) {
+        console.out() << "No graph named '" << args[0] << "'" << std::endl;
+        console.fail();
+        return;
+    }
+    if (graphs.contains(args[1])) {
+        console.out() << "Graph '" << args[1] << "' already exists, drop it first" << std::endl;
+        console.fail();
+        return;
+    }
+
+    try {
+        graphs[args[1]] = std::make_unique<Graph>(clone_graph(*source->second));
+        console.out() << "Cloned '" << args[0] << "' to '" << args[1]
+                      << "', storage is shared until either is modified" << std::endl;
     } catch (const std::exception& e) {
-        std::cout << "Error DFS: " << e.what() << std::endl;
+        console.out() << "Error clone: " << e.what() << std::endl;
+        console.fail();
     }
 }
+
+void GraphConsoleAdapter::cmd_drop(const std::vector<std::string>& args) {
+    if (args.size() != 1) {
+        console.out() << "Usage: drop <name>" << std::endl;
+        console.fail();
+        return;
+    }
+    const std::unique_lock graph_lock(lock_of(args[0]), std::try_to_lock);
+    if (!graph_lock.owns_lock()) {
+        report_busy(args[0]);
+        return;
+    }
+    bool was_active;
+    {
+        const std::lock_guard lock(registry_mutex);
+        if (!graphs.contains(args[0])) {
+            console.out() << "No graph named '" << args[0] << "'" << std::endl;
+            console.fail();
+            return;
+        }
+        was_active = args[0] == active;
+    }
+
+    drop(args[0]);
+    console.out() << "Dropped '" << args[0] << "'" << (was_active ? ", no active graph (see 'use')" : "") << std::endl;
+}
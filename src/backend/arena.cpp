@@ -0,0 +1,93 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/arena.h"
+
+#include <algorithm>
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+    constexpr std::size_t page_bytes = 4096;
+    constexpr std::size_t huge_page_bytes = std::size_t{2} << 20;
+
+    std::size_t round_up(const std::size_t value, const std::size_t step) {
+        return (value + step - 1) / step * step;
+    }
+}
+
+Arena::Arena(const ArenaOptions options) : config(options) {}
+
+Arena::~Arena() {
+    for (const auto& [base, size] : blocks) {
+#ifdef _WIN32
+        VirtualFree(base, 0, MEM_RELEASE);
+#else
+        ::munmap(base, size);
+#endif
+    }
+}
+
+void Arena::map_block(const std::size_t bytes) {
+    // Blocks at least double, so a growing graph maps O(log size) of them
+    const std::size_t previous = blocks.empty() ? 0 : blocks.back().size;
+    std::size_t size = std::max({bytes, previous * 2, min_block_bytes});
+    size = round_up(size, config.huge_pages ? huge_page_bytes : page_bytes);
+
+#ifdef _WIN32
+    void* base = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+    if (base == nullptr) throw std::bad_alloc();
+#else
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+    if (config.populate) flags |= MAP_POPULATE;
+#endif
+    void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base == MAP_FAILED) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    if (config.huge_pages) ::madvise(base, size, MADV_HUGEPAGE);
+#endif
+#endif
+
+    blocks.push_back({static_cast<char*>(base), size});
+    cursor = static_cast<char*>(base);
+    limit = cursor + size;
+}
+
+void Arena::reserve(const std::size_t bytes) {
+    const std::lock_guard lock(mutex);
+    if (cursor == nullptr || static_cast<std::size_t>(limit - cursor) < bytes) map_block(bytes);
+}
+
+void* Arena::allocate(const std::size_t bytes) {
+    const std::size_t size = round_up(std::max<std::size_t>(bytes, 1), alignment);
+    const std::lock_guard lock(mutex);
+    if (cursor == nullptr || static_cast<std::size_t>(limit - cursor) < size) map_block(size);
+    void* result = cursor;
+    cursor += size;
+    used += size;
+    return result;
+}
+
+std::size_t Arena::mapped_bytes() const {
+    const std::lock_guard lock(mutex);
+    std::size_t total = 0;
+    for (const auto& block : blocks) total += block.size;
+    return total;
+}
+
+std::size_t Arena::used_bytes() const {
+    const std::lock_guard lock(mutex);
+    return used;
+}
+
+std::size_t Arena::block_count() const {
+    const std::lock_guard lock(mutex);
+    return blocks.size();
+}
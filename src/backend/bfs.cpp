@@ -0,0 +1,445 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/bfs.h"
+#include "../../include/backend/parallel.h"
+#include "../../include/core/cancellation.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+void BFSResult::reset(const int n) {
+    distance.assign(n, -1);
+    parent.assign(n, -1);
+    level_sizes.clear();
+    top_down_steps = 0;
+    bottom_up_steps = 0;
+    edges_checked = 0;
+}
+
+namespace {
+    using word_t = BitMatrix::word_t;
+    constexpr int word_bits = BitMatrix::word_bits;
+
+    // Beamer's switching thresholds
+    constexpr long long alpha = 14;
+    constexpr long long beta = 24;
+    // Multi-source sweeps pull once the frontier holds this share of the unfinished edges
+    constexpr long long multi_pull_ratio = 2;
+    // A sweep still running at this level whose arrivals average fewer lanes per vertex than
+    // multi_min_sharing gives up: its lanes do not meet (e.g. sources far apart on a grid), and
+    // a lane word per vertex costs more memory traffic than separate searches
+    constexpr int multi_probe_level = 16;
+    constexpr double multi_min_sharing = 1.25;
+
+    bool test_bit(const word_t *bits, const int v) {
+        return (bits[v / word_bits] >> (v % word_bits) & 1u) != 0;
+    }
+
+    // Atomically set v in the visited bitmap, true if this call set it
+    bool claim(word_t *visited, const int v) {
+        const word_t bit = word_t{1} << (v % word_bits);
+        std::atomic_ref word(visited[v / word_bits]);
+        if ((word.load(std::memory_order_relaxed) & bit) != 0) return false;
+        return (word.fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    }
+
+    struct ListAccess {
+        const AdjacencyList& list;
+
+        [[nodiscard]] int degree(const int v) const { return static_cast<int>(list[v].size()); }
+
+        template <typename Visit>
+        void expand(const int u, word_t *visited, Visit &&visit, long long &checked) const {
+            checked += static_cast<long long>(list[u].size());
+            for (const int v : list[u]) {
+                if (claim(visited, v)) visit(v);
+            }
+        }
+
+        int find_parent(const int v, const word_t *frontier, long long &checked) const {
+            for (const int u : list[v]) {
+                checked++;
+                if (test_bit(frontier, u)) return u;
+            }
+            return -1;
+        }
+    };
+
+    struct MatrixAccess {
+        const BitMatrix& matrix;
+
+        [[nodiscard]] int degree(const int v) const { return matrix.row_count(v); }
+
+        // Only bits of the row that are still unvisited are tried
+        template <typename Visit>
+        void expand(const int u, word_t *visited, Visit &&visit, long long &checked) const {
+            const word_t *row = matrix.row(u);
+            const auto words = static_cast<int>(matrix.row_words());
+            checked += words;
+            for (int w = 0; w < words; w++) {
+                word_t candidates = row[w] & ~std::atomic_ref(visited[w]).load(std::memory_order_relaxed);
+                while (candidates != 0) {
+                    const int v = w * word_bits + std::countr_zero(candidates);
+                    if (claim(visited, v)) visit(v);
+                    candidates &= candidates - 1;
+                }
+            }
+        }
+
+        // Row AND frontier a word at a time, no per-edge checks at all
+        int find_parent(const int v, const word_t *frontier, long long &checked) const {
+            const word_t *row = matrix.row(v);
+            const auto words = static_cast<int>(matrix.row_words());
+            for (int w = 0; w < words; w++) {
+                checked++;
+                if (const word_t hits = row[w] & frontier[w]; hits != 0) {
+                    return w * word_bits + std::countr_zero(hits);
+                }
+            }
+            return -1;
+        }
+    };
+
+    template <typename Access>
+    void run_bfs(const Access &access, const int n, const int source, BFSResult &out, const int threads) {
+        out.reset(n);
+        if (source < 0 || source >= n) return;
+
+        const std::size_t words = BitMatrix::words_for(n);
+        const int workers = resolve_threads(threads);
+
+        std::vector<int> degree(n);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) degree[v] = access.degree(static_cast<int>(v));
+        });
+
+        std::vector<word_t> visited(words, 0), frontier_bits(words, 0), next_bits(words, 0);
+        std::vector<int> frontier{source};
+        std::vector<std::vector<int>> local(workers);
+        std::vector<long long> checked(workers, 0), found(workers, 0), scout(workers, 0);
+
+        visited[source / word_bits] |= word_t{1} << (source % word_bits);
+        out.distance[source] = 0;
+        out.level_sizes.push_back(1);
+
+        long long unexplored = std::accumulate(degree.begin(), degree.end(), 0LL) - degree[source];
+        long long frontier_edges = degree[source];
+        long long frontier_size = 1;
+        bool bottom_up = false;
+
+        for (int level = 0; frontier_size > 0; level++) {
+            check_cancelled();
+            // Direction switch, converting the frontier between queue and bitmap
+            if (!bottom_up && frontier_edges > unexplored / alpha) {
+                bottom_up = true;
+                std::ranges::fill(frontier_bits, 0);
+                for (const int v : frontier) frontier_bits[v / word_bits] |= word_t{1} << (v % word_bits);
+            } else if (bottom_up && frontier_size < n / beta) {
+                bottom_up = false;
+                frontier.clear();
+                for (std::size_t w = 0; w < words; w++) {
+                    for (word_t bits = frontier_bits[w]; bits != 0; bits &= bits - 1) {
+                        frontier.push_back(static_cast<int>(w) * word_bits + std::countr_zero(bits));
+                    }
+                }
+            }
+
+            std::ranges::fill(found, 0);
+            std::ranges::fill(scout, 0);
+
+            if (bottom_up) {
+                // Every thread owns whole words of visited/next, no atomics needed
+                parallel_for(words, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+                    for (std::size_t w = begin; w < end; w++) {
+                        word_t next = 0;
+                        word_t candidates = ~visited[w];
+                        if (w == words - 1 && n % word_bits != 0) candidates &= (word_t{1} << (n % word_bits)) - 1;
+                        for (; candidates != 0; candidates &= candidates - 1) {
+                            const int v = static_cast<int>(w) * word_bits + std::countr_zero(candidates);
+                            if (const int p = access.find_parent(v, frontier_bits.data(), checked[id]); p >= 0) {
+                                out.parent[v] = p;
+                                out.distance[v] = level + 1;
+                                next |= word_t{1} << (v % word_bits);
+                                found[id]++;
+                                scout[id] += degree[v];
+                            }
+                        }
+                        next_bits[w] = next;
+                        visited[w] |= next;
+                    }
+                }, 64);
+                std::swap(frontier_bits, next_bits);
+                out.bottom_up_steps++;
+            } else {
+                parallel_for(frontier.size(), threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+                    for (std::size_t i = begin; i < end; i++) {
+                        const int u = frontier[i];
+                        access.expand(u, visited.data(), [&](const int v) {
+                            out.parent[v] = u;
+                            out.distance[v] = level + 1;
+                            local[id].push_back(v);
+                            found[id]++;
+                            scout[id] += degree[v];
+                        }, checked[id]);
+                    }
+                });
+                frontier.clear();
+                for (auto& part : local) {
+                    frontier.insert(frontier.end(), part.begin(), part.end());
+                    part.clear();
+                }
+                out.top_down_steps++;
+            }
+
+            frontier_size = std::accumulate(found.begin(), found.end(), 0LL);
+            frontier_edges = std::accumulate(scout.begin(), scout.end(), 0LL);
+            unexplored -= frontier_edges;
+            if (frontier_size > 0) out.level_sizes.push_back(static_cast<int>(frontier_size));
+        }
+
+        out.edges_checked = std::accumulate(checked.begin(), checked.end(), 0LL);
+    }
+}
+
+void BFS(const int v, const Graph &graph, BFSResult &out, const int threads) {
+    run_bfs(MatrixAccess{graph.adj_matrix}, graph.n, v, out, threads);
+}
+
+void BFS_list(const int v, const Graph &graph, BFSResult &out, const int threads) {
+    run_bfs(ListAccess{graph.adj_list}, graph.n, v, out, threads);
+}
+
+namespace {
+    template <int Lanes>
+    using LaneWords = std::array<word_t, Lanes>;
+
+    // Per-vertex lanes of a multi-source sweep, kept together so a visit touches one cache line
+    template <int Lanes>
+    struct LaneState {
+        LaneWords<Lanes> seen;      // Sources that reached the vertex
+        LaneWords<Lanes> visit[2];  // Sources that reached it last level (level & 1) and this level
+        int degree = 0;
+    };
+
+    // Calls fn(v) for every vertex set in words [begin, end) of a bitmap, in increasing order
+    template <typename Fn>
+    void for_each_bit(const word_t *bits, const std::size_t begin, const std::size_t end, Fn &&fn) {
+        for (std::size_t w = begin; w < end; w++) {
+            for (word_t word = bits[w]; word != 0; word &= word - 1) {
+                fn(static_cast<int>(w) * word_bits + std::countr_zero(word));
+            }
+        }
+    }
+
+    // False when the sweep gave up at multi_probe_level, out is then only partly filled
+    template <int Lanes>
+    bool run_multi_bfs(const Graph &graph, MultiBFSResult &out, const int threads, const bool keep_distances) {
+        const int n = graph.n;
+        const int k = static_cast<int>(out.sources.size());
+        const std::size_t words = BitMatrix::words_for(n);
+        const int workers = resolve_threads(threads);
+        const AdjacencyList& list = graph.adj_list;
+        constexpr LaneWords<Lanes> none{};
+
+        // All-ones pattern for the lanes in use, vertices that match it are finished
+        LaneWords<Lanes> full{};
+        for (int i = 0; i < k; i++) full[i / word_bits] |= word_t{1} << (i % word_bits);
+
+        std::vector<LaneState<Lanes>> state(n);
+        // Adjacency entries of vertices that are not finished yet, i.e. the cost of a pull step
+        long long unfinished = 0;
+        for (int v = 0; v < n; v++) {
+            state[v].degree = static_cast<int>(list[v].size());
+            unfinished += state[v].degree;
+        }
+
+        // The frontier is a bitmap, so both directions walk it in vertex order and the lanes
+        // are touched in address order; visit[level & 1] is non-zero exactly on the frontier
+        std::vector<word_t> frontier_bits(words, 0), next_bits(words, 0);
+        long long frontier_edges = 0;
+        for (int i = 0; i < k; i++) {
+            const int s = out.sources[i];
+            if (!test_bit(frontier_bits.data(), s)) frontier_edges += state[s].degree;
+            frontier_bits[s / word_bits] |= word_t{1} << (s % word_bits);
+            state[s].seen[i / word_bits] |= word_t{1} << (i % word_bits);
+            state[s].visit[1][i / word_bits] |= word_t{1} << (i % word_bits);
+            if (keep_distances) out.distance[static_cast<std::size_t>(i) * n + s] = 0;
+        }
+
+        // Per-thread arrivals of each source in the current level
+        std::vector<std::vector<long long>> arrivals(workers, std::vector<long long>(k, 0));
+        std::vector<long long> found(workers, 0), scout(workers, 0), finished(workers, 0);
+        int* distance = keep_distances ? out.distance.data() : nullptr;
+        long long lane_arrivals = 0, vertex_arrivals = 0;
+
+        // Account for lanes that reached u first at this level
+        const auto record = [n, distance](long long *count, const int u, const int l, word_t fresh, const int level) {
+            for (; fresh != 0; fresh &= fresh - 1) {
+                const int i = l * word_bits + std::countr_zero(fresh);
+                count[i]++;
+                if (distance != nullptr) distance[static_cast<std::size_t>(i) * n + u] = level;
+            }
+        };
+
+        for (int level = 1;; level++) {
+            check_cancelled();
+            std::ranges::fill(found, 0);
+            std::ranges::fill(scout, 0);
+            std::ranges::fill(finished, 0);
+            const int current = level & 1, arriving = current ^ 1;
+
+            // Same trade-off as run_bfs, except that a pull sweep cannot stop early: it costs the
+            // edges of every unfinished vertex, including vertices no source can ever reach
+            if (frontier_edges > unfinished / multi_pull_ratio) {
+                // Threads own whole words of vertices and only read the neighbours' current lanes
+                parallel_for(words, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+                    long long *count = arrivals[id].data();
+                    for (std::size_t w = begin; w < end; w++) {
+                        word_t next = 0;
+                        const int last = std::min(n, static_cast<int>(w + 1) * word_bits);
+                        for (int u = static_cast<int>(w) * word_bits; u < last; u++) {
+                            LaneState<Lanes>& target = state[u];
+                            if (target.seen == full) continue;
+                            LaneWords<Lanes> incoming{};
+                            for (const int v : list[u]) {
+                                for (int l = 0; l < Lanes; l++) incoming[l] |= state[v].visit[current][l];
+                            }
+                            bool any = false;
+                            for (int l = 0; l < Lanes; l++) {
+                                const word_t fresh = incoming[l] & ~target.seen[l];
+                                if (fresh == 0) continue;
+                                any = true;
+                                target.seen[l] |= fresh;
+                                target.visit[arriving][l] = fresh;
+                                record(count, u, l, fresh, level);
+                            }
+                            if (!any) continue;
+                            next |= word_t{1} << (u % word_bits);
+                            found[id]++;
+                            scout[id] += target.degree;
+                        }
+                        next_bits[w] = next;
+                    }
+                }, 4);
+            } else {
+                // Push: whoever sets a lane in seen owns that arrival, the first arrival queues the vertex
+                parallel_for(words, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+                    long long *count = arrivals[id].data();
+                    for_each_bit(frontier_bits.data(), begin, end, [&](const int u) {
+                        const LaneWords<Lanes> lanes = state[u].visit[current];
+                        for (const int v : list[u]) {
+                            LaneState<Lanes>& target = state[v];
+                            bool any = false;
+                            for (int l = 0; l < Lanes; l++) {
+                                std::atomic_ref seen(target.seen[l]);
+                                word_t fresh = lanes[l] & ~seen.load(std::memory_order_relaxed);
+                                if (fresh != 0) fresh &= ~seen.fetch_or(fresh, std::memory_order_relaxed);
+                                if (fresh == 0) continue;
+                                any = true;
+                                std::atomic_ref(target.visit[arriving][l]).fetch_or(fresh, std::memory_order_relaxed);
+                                record(count, v, l, fresh, level);
+                            }
+                            if (!any) continue;
+                            if (claim(next_bits.data(), v)) {
+                                found[id]++;
+                                scout[id] += target.degree;
+                            }
+                        }
+                    });
+                }, 64);
+            }
+
+            // The frontier drops out, the vertices reached this level take its place. A finished
+            // vertex is counted once, on the level after its last arrival
+            parallel_for(words, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+                for_each_bit(frontier_bits.data(), begin, end, [&](const int u) {
+                    state[u].visit[current] = none;
+                    if (state[u].seen == full && !test_bit(next_bits.data(), u)) finished[id] += state[u].degree;
+                });
+                std::fill(frontier_bits.begin() + static_cast<std::ptrdiff_t>(begin),
+                          frontier_bits.begin() + static_cast<std::ptrdiff_t>(end), 0);
+            }, 1024);
+            std::swap(frontier_bits, next_bits);
+            const long long reached_vertices = std::accumulate(found.begin(), found.end(), 0LL);
+            if (reached_vertices == 0) break;
+            frontier_edges = std::accumulate(scout.begin(), scout.end(), 0LL);
+            unfinished -= std::accumulate(finished.begin(), finished.end(), 0LL);
+            out.levels = level;
+
+            // A source whose reach grew this level has its eccentricity at least here
+            for (int i = 0; i < k; i++) {
+                long long total = 0;
+                for (auto& count : arrivals) total += std::exchange(count[i], 0);
+                if (total == 0) continue;
+                out.reached[i] += total;
+                out.distance_sum[i] += total * level;
+                out.eccentricity[i] = level;
+                lane_arrivals += total;
+            }
+            vertex_arrivals += reached_vertices;
+            if (level == multi_probe_level
+                && static_cast<double>(lane_arrivals) < multi_min_sharing * static_cast<double>(vertex_arrivals)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // BFS_multi without shared lanes: one direction-optimizing search per source
+    void separate_bfs(const Graph &graph, MultiBFSResult &out, const int threads, const bool keep_distances) {
+        const std::size_t n = static_cast<std::size_t>(graph.n);
+        BFSResult single;
+        out.levels = 0;
+        for (std::size_t i = 0; i < out.sources.size(); i++) {
+            run_bfs(ListAccess{graph.adj_list}, graph.n, out.sources[i], single, threads);
+            const std::vector<int>& sizes = single.level_sizes;
+            out.reached[i] = std::accumulate(sizes.begin(), sizes.end(), 0LL);
+            out.eccentricity[i] = static_cast<int>(sizes.size()) - 1;
+            out.distance_sum[i] = 0;
+            for (std::size_t d = 1; d < sizes.size(); d++) out.distance_sum[i] += static_cast<long long>(d) * sizes[d];
+            out.levels = std::max(out.levels, out.eccentricity[i]);
+            if (keep_distances) std::ranges::copy(single.distance, out.distance.begin() + static_cast<std::ptrdiff_t>(i * n));
+        }
+    }
+
+    template <int Lanes>
+    bool dispatch_multi_bfs(const Graph &graph, MultiBFSResult &out, const int threads, const bool keep_distances) {
+        if constexpr (Lanes < max_multi_sources / word_bits) {
+            if (static_cast<int>(out.sources.size()) > Lanes * word_bits) {
+                return dispatch_multi_bfs<Lanes * 2>(graph, out, threads, keep_distances);
+            }
+        }
+        return run_multi_bfs<Lanes>(graph, out, threads, keep_distances);
+    }
+}
+
+void BFS_multi(const std::vector<int> &sources, const Graph &graph, MultiBFSResult &out, const int threads,
+               const bool keep_distances) {
+    if (sources.size() > static_cast<std::size_t>(max_multi_sources)) {
+        throw std::invalid_argument("at most " + std::to_string(max_multi_sources) + " sources per sweep");
+    }
+    for (const int s : sources) {
+        if (s < 0 || s >= graph.n) throw std::out_of_range("source vertex " + std::to_string(s) + " out of range");
+    }
+
+    const std::size_t k = sources.size();
+    out.sources = sources;
+    out.reached.assign(k, 1);
+    out.eccentricity.assign(k, 0);
+    out.distance_sum.assign(k, 0);
+    out.distance.clear();
+    if (keep_distances) out.distance.assign(k * static_cast<std::size_t>(graph.n), -1);
+    out.levels = 0;
+    if (k == 0) return;
+
+    // Lane count is rounded up to a power of two so the per-vertex loops unroll
+    if (!dispatch_multi_bfs<1>(graph, out, threads, keep_distances)) separate_bfs(graph, out, threads, keep_distances);
+}
@@ -0,0 +1,68 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/bit_matrix.h"
+
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
+BitMatrix::BitMatrix(const int rows, const int cols) : n_rows(rows), n_cols(cols) {
+    if (rows <= 0 || cols <= 0) {
+        n_rows = n_cols = 0;
+        return;
+    }
+
+    row_stride = padded_stride(cols);
+    words.assign(static_cast<std::size_t>(rows) * row_stride, 0);
+}
+
+BitMatrix::BitMatrix(const int rows, const int cols, SharedArray<word_t> storage) : n_rows(rows), n_cols(cols) {
+    if (rows <= 0 || cols <= 0) {
+        n_rows = n_cols = 0;
+        return;
+    }
+
+    row_stride = padded_stride(cols);
+    if (storage.size() != static_cast<std::size_t>(rows) * row_stride) {
+        throw std::invalid_argument("BitMatrix storage does not match the row layout");
+    }
+    words = std::move(storage);
+}
+
+BitMatrix::~BitMatrix() {
+    release();
+}
+
+BitMatrix::BitMatrix(BitMatrix &&other) noexcept
+    : words(std::move(other.words)),
+      row_stride(std::exchange(other.row_stride, 0)),
+      n_rows(std::exchange(other.n_rows, 0)),
+      n_cols(std::exchange(other.n_cols, 0)) {}
+
+BitMatrix& BitMatrix::operator=(BitMatrix &&other) noexcept {
+    if (this != &other) {
+        release();
+        words = std::move(other.words);
+        row_stride = std::exchange(other.row_stride, 0);
+        n_rows = std::exchange(other.n_rows, 0);
+        n_cols = std::exchange(other.n_cols, 0);
+    }
+    return *this;
+}
+
+int BitMatrix::row_count(const int r) const {
+    const word_t* bits = row(r);
+    int count = 0;
+    for (std::size_t w = 0; w < row_words(); w++) {
+        count += std::popcount(bits[w]);
+    }
+    return count;
+}
+
+void BitMatrix::release() {
+    words.clear();
+    row_stride = 0;
+    n_rows = n_cols = 0;
+}
@@ -0,0 +1,114 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/components.h"
+#include "../../include/backend/parallel.h"
+#include "../../include/backend/random.h"
+
+#include <atomic>
+#include <bit>
+#include <unordered_map>
+
+namespace {
+    // Neighbours per vertex linked before the giant component is sampled
+    constexpr int neighbour_rounds = 2;
+    constexpr int sample_size = 1024;
+
+    int load(std::vector<int>& comp, const int v) {
+        return std::atomic_ref(comp[v]).load(std::memory_order_relaxed);
+    }
+
+    // Hook the higher root under the lower one, retry while other threads move the roots
+    void link(const int u, const int v, std::vector<int>& comp) {
+        int p1 = load(comp, u);
+        int p2 = load(comp, v);
+        while (p1 != p2) {
+            const int high = std::max(p1, p2);
+            const int low = std::min(p1, p2);
+            int p_high = load(comp, high);
+            if (p_high == low) break;
+            if (p_high == high && std::atomic_ref(comp[high]).compare_exchange_strong(p_high, low)) break;
+            p1 = load(comp, load(comp, high));
+            p2 = load(comp, low);
+        }
+    }
+
+    void compress(std::vector<int>& comp, const int threads) {
+        parallel_for(comp.size(), threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                while (comp[v] != comp[comp[v]]) comp[v] = comp[comp[v]];
+            }
+        });
+    }
+
+    // Most frequent root among a fixed random sample of vertices
+    int sample_frequent(const std::vector<int>& comp) {
+        std::unordered_map<int, int> counts;
+        SplitMix64 rng(comp.size());
+        for (int i = 0; i < sample_size; i++) {
+            counts[comp[rng.next() % comp.size()]]++;
+        }
+        int best = comp[0], best_count = 0;
+        for (const auto& [root, count] : counts) {
+            if (count > best_count) {
+                best = root;
+                best_count = count;
+            }
+        }
+        return best;
+    }
+}
+
+Components connected_components(const Graph &graph, const int threads) {
+    const int n = graph.n;
+    std::vector<int> comp(n);
+    for (int v = 0; v < n; v++) comp[v] = v;
+
+    for (int round = 0; round < neighbour_rounds; round++) {
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t u = begin; u < end; u++) {
+                const auto& neighbours = graph.adj_list[u];
+                if (round < static_cast<int>(neighbours.size())) link(static_cast<int>(u), neighbours[round], comp);
+            }
+        });
+        compress(comp, threads);
+    }
+
+    // Edges of the sampled giant component can be skipped: the graph is undirected,
+    // so every other vertex reaches it through its own list
+    const int giant = n > 0 ? sample_frequent(comp) : 0;
+    parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        for (std::size_t u = begin; u < end; u++) {
+            if (load(comp, static_cast<int>(u)) == giant) continue;
+            const auto& neighbours = graph.adj_list[u];
+            for (std::size_t i = neighbour_rounds; i < neighbours.size(); i++) {
+                link(static_cast<int>(u), neighbours[i], comp);
+            }
+        }
+    });
+    compress(comp, threads);
+
+    // Roots are the smallest vertex of each component, so ids come out in vertex order
+    Components result;
+    result.label.assign(n, -1);
+    for (int v = 0; v < n; v++) {
+        if (comp[v] == v) {
+            result.label[v] = result.count();
+            result.size.push_back(0);
+        }
+        result.label[v] = result.label[comp[v]];
+        result.size[result.label[v]]++;
+    }
+    return result;
+}
+
+std::vector<int> component_size_histogram(const Components &components) {
+    std::vector<int> histogram;
+    for (const int size : components.size) {
+        const auto bucket = static_cast<std::size_t>(std::bit_width(static_cast<unsigned>(size)) - 1);
+        if (histogram.size() <= bucket) histogram.resize(bucket + 1, 0);
+        histogram[bucket]++;
+    }
+    return histogram;
+}
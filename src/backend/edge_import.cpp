@@ -0,0 +1,280 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/edge_import.h"
+#include "../../include/backend/parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+    using Edge = std::pair<int, int>;
+
+    // Pieces per worker a chunk is split into, evens out lines of different length
+    constexpr int parts_per_worker = 4;
+    // Vertices per block of the counting sort, 8192 keeps a block's rows in L2 for typical degrees
+    constexpr int block_shift = 13;
+
+    bool is_blank(const char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    }
+
+    bool is_separator(const char c) {
+        return c == ' ' || c == '\t' || c == ',' || c == ';';
+    }
+
+    // Unsigned vertex id at p, nullptr if there is none or it does not fit an int
+    const char* parse_id(const char* p, const char* end, int& value) {
+        if (p == end || *p < '0' || *p > '9') return nullptr;
+        long long result = 0;
+        for (; p < end && *p >= '0' && *p <= '9'; p++) {
+            result = result * 10 + (*p - '0');
+            if (result >= INT_MAX) return nullptr;
+        }
+        value = static_cast<int>(result);
+        return p;
+    }
+
+    /**
+     * Parse whole lines of [p, end) into out
+     * @return Position of the first malformed line, nullptr when everything parsed
+     */
+    const char* parse_lines(const char* p, const char* end, std::vector<Edge>& out, int& max_id) {
+        while (p < end) {
+            while (p < end && is_blank(*p)) p++;
+            if (p == end) break;
+            if (*p == '\n') {
+                p++;
+                continue;
+            }
+
+            const char* line = p;
+            if (*p != '#' && *p != '%') {
+                int u = 0, v = 0;
+                p = parse_id(p, end, u);
+                if (p == nullptr || p == end || !is_separator(*p)) return line;
+                while (p < end && is_separator(*p)) p++;
+                p = parse_id(p, end, v);
+                if (p == nullptr) return line;
+                out.emplace_back(u, v);
+                max_id = std::max(max_id, std::max(u, v));
+            }
+
+            // Rest of the line (comment text, weights, timestamps) is not looked at
+            const auto* newline = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            p = newline == nullptr ? end : newline + 1;
+        }
+        return nullptr;
+    }
+
+    struct FileCloser {
+        void operator()(std::FILE* file) const { std::fclose(file); }
+    };
+
+    /**
+     * Stream the file chunk by chunk, the next chunk is read on a helper thread
+     * while the current one is parsed. Lines never straddle a parsed chunk.
+     */
+    void read_edges(const std::string& path, std::vector<std::vector<Edge>>& edges, int& max_id,
+                    ImportStats& stats, const int threads) {
+        const std::unique_ptr<std::FILE, FileCloser> file(std::fopen(path.c_str(), "rb"));
+        if (file == nullptr) throw std::runtime_error("cannot open " + path);
+        std::setvbuf(file.get(), nullptr, _IONBF, 0);
+
+        const int workers = resolve_threads(threads);
+        const int parts = workers * parts_per_worker;
+        std::vector<int> part_max(parts, -1);
+        std::vector<const char*> part_error(parts, nullptr);
+
+        // Left uninitialized, every byte is written by fread before it is parsed
+        std::unique_ptr<char[]> current(new char[import_chunk_bytes]), next(new char[import_chunk_bytes]);
+        std::size_t length = std::fread(current.get(), 1, import_chunk_bytes, file.get());
+        std::size_t consumed = 0;
+
+        while (length > 0) {
+            const bool last = length < import_chunk_bytes;
+            std::size_t cut = length;
+            if (!last) {
+                const char* newline = nullptr;
+                for (std::size_t i = length; i > 0 && newline == nullptr; i--) {
+                    if (current[i - 1] == '\n') newline = current.get() + i - 1;
+                }
+                if (newline == nullptr) throw std::runtime_error("line longer than the import chunk");
+                cut = static_cast<std::size_t>(newline - current.get()) + 1;
+            }
+
+            // Carry the unfinished line over and read behind it while this chunk is parsed
+            const std::size_t tail = length - cut;
+            std::memcpy(next.get(), current.get() + cut, tail);
+            std::size_t next_length = tail;
+            std::thread reader;
+            if (!last) {
+                reader = std::thread([&] {
+                    next_length += std::fread(next.get() + tail, 1, import_chunk_bytes - tail, file.get());
+                });
+            }
+
+            const char* base = current.get();
+            std::vector<const char*> bounds(parts + 1, base + cut);
+            bounds[0] = base;
+            for (int i = 1; i < parts; i++) {
+                const char* guess = std::max(bounds[i - 1], base + cut * i / parts);
+                const auto* newline = static_cast<const char*>(std::memchr(guess, '\n', base + cut - guess));
+                bounds[i] = newline == nullptr ? base + cut : newline + 1;
+            }
+            parallel_for(parts, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+                for (std::size_t i = begin; i < end; i++) {
+                    part_error[i] = parse_lines(bounds[i], bounds[i + 1], edges[id], part_max[i]);
+                }
+            }, 1);
+
+            if (reader.joinable()) reader.join();
+            for (int i = 0; i < parts; i++) {
+                if (part_error[i] != nullptr) {
+                    const auto offset = consumed + static_cast<std::size_t>(part_error[i] - base);
+                    throw std::runtime_error("malformed edge at byte " + std::to_string(offset) + " of " + path);
+                }
+            }
+            if (std::ferror(file.get())) throw std::runtime_error("read from " + path + " failed");
+
+            consumed += cut;
+            std::swap(current, next);
+            length = next_length;
+        }
+
+        stats.bytes = consumed;
+        max_id = *std::ranges::max_element(part_max);
+    }
+
+    /**
+     * Counting sort by source in two passes, so no pass scatters across the whole array:
+     * entries are first binned by source block (sequential streams per block), then every
+     * block, small enough to stay in cache, is counted, scattered, sorted and deduplicated.
+     * Both directions of an edge are emitted, loops once. edges is released on the way.
+     */
+    void build_from_edges(Graph& graph, std::vector<std::vector<Edge>>& edges, ImportStats& stats,
+                          const int threads) {
+        const int n = graph.n;
+        const std::size_t parts = edges.size();
+        const std::size_t blocks = (static_cast<std::size_t>(n) >> block_shift) + 1;
+
+        std::vector<std::size_t> position(parts * blocks, 0);
+        parallel_for(parts, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t p = begin; p < end; p++) {
+                std::size_t* count = position.data() + p * blocks;
+                for (const auto& [u, v] : edges[p]) {
+                    count[u >> block_shift]++;
+                    if (u != v) count[v >> block_shift]++;
+                }
+            }
+        }, 1);
+
+        // Block-major prefix sum: every part writes its own slice of every block
+        std::vector<std::size_t> block_start(blocks + 1, 0);
+        std::size_t total = 0;
+        for (std::size_t b = 0; b < blocks; b++) {
+            block_start[b] = total;
+            for (std::size_t p = 0; p < parts; p++) {
+                const std::size_t count = position[p * blocks + b];
+                position[p * blocks + b] = total;
+                total += count;
+            }
+        }
+        block_start[blocks] = total;
+
+        std::vector<Edge> binned(total);
+        parallel_for(parts, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t p = begin; p < end; p++) {
+                std::size_t* cursor = position.data() + p * blocks;
+                for (const auto& [u, v] : edges[p]) {
+                    binned[cursor[u >> block_shift]++] = {u, v};
+                    if (u != v) binned[cursor[v >> block_shift]++] = {v, u};
+                }
+                edges[p] = {};
+            }
+        }, 1);
+
+        std::vector<int> scattered(total);
+        std::vector<std::size_t> start(n + 1, 0);
+        std::vector<std::size_t> degree(n, 0);
+        std::vector<std::size_t> loops(resolve_threads(threads), 0);
+        parallel_for(blocks, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+            for (std::size_t b = begin; b < end; b++) {
+                const int first_vertex = static_cast<int>(b << block_shift);
+                const int last_vertex = static_cast<int>(std::min<std::size_t>(n, (b + 1) << block_shift));
+
+                for (std::size_t i = block_start[b]; i < block_start[b + 1]; i++) degree[binned[i].first]++;
+                std::size_t offset = block_start[b];
+                for (int v = first_vertex; v < last_vertex; v++) {
+                    start[v] = offset;
+                    offset += degree[v];
+                    degree[v] = start[v];
+                }
+                for (std::size_t i = block_start[b]; i < block_start[b + 1]; i++) {
+                    scattered[degree[binned[i].first]++] = binned[i].second;
+                }
+
+                // Sort and deduplicate every row in place, degree becomes the distinct degree
+                for (int v = first_vertex; v < last_vertex; v++) {
+                    const auto row = scattered.begin() + static_cast<std::ptrdiff_t>(start[v]);
+                    const auto row_end = scattered.begin() + static_cast<std::ptrdiff_t>(degree[v]);
+                    std::sort(row, row_end);
+                    const auto unique_end = std::unique(row, row_end);
+                    degree[v] = static_cast<std::size_t>(unique_end - row);
+                    if (std::binary_search(row, unique_end, v)) loops[id]++;
+                }
+            }
+        }, 1);
+        binned = {};
+
+        std::size_t distinct_entries = 0;
+        for (int v = 0; v < n; v++) distinct_entries += degree[v];
+        if (distinct_entries > std::numeric_limits<CSR::offset_type>::max()) {
+            throw std::length_error("Graph too large for CSR offsets, rebuild with CSR_64BIT_OFFSETS");
+        }
+
+        // One arena reservation for both arrays
+        graph.arena->reserve((n + 1) * sizeof(CSR::offset_type) + distinct_entries * sizeof(int) + 2 * Arena::alignment);
+        graph.csr.offsets = graph.allocate<CSR::offset_type>(n + 1);
+        for (int v = 0; v < n; v++) {
+            graph.csr.offsets[v + 1] = graph.csr.offsets[v] + static_cast<CSR::offset_type>(degree[v]);
+        }
+        graph.csr.neighbours = graph.allocate<int>(distinct_entries);
+
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                const auto first = scattered.begin() + static_cast<std::ptrdiff_t>(start[v]);
+                std::copy(first, first + static_cast<std::ptrdiff_t>(degree[v]),
+                          graph.csr.neighbours.begin() + static_cast<std::ptrdiff_t>(graph.csr.offsets[v]));
+            }
+        });
+
+        for (const std::size_t count : loops) stats.loops += count;
+        const std::size_t distinct = (distinct_entries - stats.loops) / 2 + stats.loops;
+        stats.duplicates = stats.edges - distinct;
+    }
+}
+
+Graph import_edge_list(const std::string &path, ImportStats &stats, const int threads, const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    stats = {};
+    std::vector<std::vector<Edge>> edges(resolve_threads(threads));
+    int max_id = -1;
+    read_edges(path, edges, max_id, stats, threads);
+    if (max_id < 0) throw std::runtime_error("no edges in " + path);
+
+    for (const auto& part : edges) stats.edges += part.size();
+
+    Graph graph(max_id + 1, arena);
+    build_from_edges(graph, edges, stats, threads);
+    graph.build_ms.generate = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return graph;
+}
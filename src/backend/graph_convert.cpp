@@ -0,0 +1,176 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/graph_convert.h"
+#include "../../include/backend/parallel.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    using word_t = BitMatrix::word_t;
+    constexpr int word_bits = BitMatrix::word_bits;
+
+    double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Call fn(j) for every set bit j of matrix row v, ascending
+    template <typename Fn>
+    void for_each_bit(const BitMatrix& matrix, const int v, Fn&& fn) {
+        const word_t* row = matrix.row(v);
+        const std::size_t words = matrix.row_words();
+        for (std::size_t w = 0; w < words; w++) {
+            for (word_t bits = row[w]; bits != 0; bits &= bits - 1) {
+                fn(static_cast<int>(w) * word_bits + std::countr_zero(bits));
+            }
+        }
+    }
+
+    // Every matrix row is owned by one thread, no atomics needed
+    template <typename Adjacency>
+    void fill_matrix(BitMatrix& matrix, const Adjacency& adjacency, const int n, const int threads) {
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                for (const int j : adjacency[static_cast<int>(v)]) matrix.set(static_cast<int>(v), j);
+            }
+        });
+    }
+
+    // Self-loop and adjacency entry totals over rows that can hold anything in any order
+    template <typename Adjacency>
+    void count_entries(const Adjacency& adjacency, const int n, const int threads, long long& entries, long long& loops) {
+        std::vector<long long> part_entries(resolve_threads(threads), 0), part_loops(resolve_threads(threads), 0);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+            for (std::size_t v = begin; v < end; v++) {
+                const auto& row = adjacency[static_cast<int>(v)];
+                part_entries[id] += static_cast<long long>(row.size());
+                part_loops[id] += std::ranges::count(row, static_cast<int>(v));
+            }
+        });
+        entries = std::accumulate(part_entries.begin(), part_entries.end(), 0LL);
+        loops = std::accumulate(part_loops.begin(), part_loops.end(), 0LL);
+    }
+}
+
+const BitMatrix& ensure_matrix(Graph &graph, const int threads) {
+    if (graph.has_matrix() || graph.n <= 0) return graph.adj_matrix;
+    if (graph.n > max_matrix_vertices) {
+        throw std::length_error("adjacency matrix of " + std::to_string(graph.n) + " vertices is over the "
+                                + std::to_string(max_matrix_vertices) + " vertex limit");
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    BitMatrix matrix = graph.allocate_matrix();
+    if (graph.has_csr()) fill_matrix(matrix, graph.csr, graph.n, threads);
+    else fill_matrix(matrix, ensure_list(graph, threads), graph.n, threads);
+    graph.adj_matrix = std::move(matrix);
+    graph.build_ms.matrix = elapsed_ms(start);
+    return graph.adj_matrix;
+}
+
+const AdjacencyList& ensure_list(Graph &graph, const int threads) {
+    if (graph.has_list() || graph.n <= 0) {
+        // Rows that lost edges since the last read still hold tombstones
+        if (graph.adj_list.tombstones() > 0) graph.adj_list.compact();
+        return graph.adj_list;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::uint32_t> degree(graph.n);
+    parallel_for(graph.n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        for (std::size_t v = begin; v < end; v++) {
+            degree[v] = static_cast<std::uint32_t>(graph.has_csr() ? graph.csr.degree(static_cast<int>(v))
+                                                                   : graph.adj_matrix.row_count(static_cast<int>(v)));
+        }
+    });
+
+    // Rows are laid out in one arena block, so the fill below never allocates
+    AdjacencyList list(graph.n, graph.arena);
+    list.layout(degree);
+    parallel_for(graph.n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        for (std::size_t v = begin; v < end; v++) {
+            const int row = static_cast<int>(v);
+            if (graph.has_csr()) list.assign(row, graph.csr[row]);
+            else for_each_bit(graph.adj_matrix, row, [&](const int j) { list.push_back(row, j); });
+        }
+    });
+    graph.adj_list = std::move(list);
+    graph.build_ms.list = elapsed_ms(start);
+    return graph.adj_list;
+}
+
+const CSR& ensure_csr(Graph &graph, const int threads) {
+    if (graph.has_csr() || graph.n <= 0) return graph.csr;
+
+    const auto start = std::chrono::steady_clock::now();
+    const int n = graph.n;
+    const bool from_list = graph.has_list();
+    if (from_list) ensure_list(graph, threads);
+
+    CSR csr;
+    csr.offsets = graph.allocate<CSR::offset_type>(n + 1);
+    parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        for (std::size_t v = begin; v < end; v++) {
+            csr.offsets[v + 1] = static_cast<CSR::offset_type>(
+                from_list ? graph.adj_list[static_cast<int>(v)].size() : graph.adj_matrix.row_count(static_cast<int>(v)));
+        }
+    });
+
+    std::size_t total = 0;
+    for (int v = 0; v < n; v++) {
+        total += csr.offsets[v + 1];
+        if (total > std::numeric_limits<CSR::offset_type>::max()) {
+            throw std::length_error("Graph too large for CSR offsets, rebuild with CSR_64BIT_OFFSETS");
+        }
+        csr.offsets[v + 1] = static_cast<CSR::offset_type>(total);
+    }
+    csr.neighbours = graph.allocate<int>(total);
+
+    parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        for (std::size_t v = begin; v < end; v++) {
+            int* out = csr.neighbours.data() + csr.offsets[v];
+            if (from_list) std::ranges::copy(graph.adj_list[static_cast<int>(v)], out);
+            else for_each_bit(graph.adj_matrix, static_cast<int>(v), [&](const int j) { *out++ = j; });
+        }
+    });
+    graph.csr = std::move(csr);
+    graph.build_ms.csr = elapsed_ms(start);
+    return graph.csr;
+}
+
+GraphStats graph_stats(const Graph &graph, const int threads) {
+    GraphStats stats;
+    stats.vertices = graph.n;
+    stats.matrix_bytes = graph.adj_matrix.bytes();
+    stats.csr_bytes = graph.csr.bytes();
+    stats.list_bytes = graph.adj_list.bytes();
+
+    long long entries = 0;
+    if (graph.has_csr()) {
+        count_entries(graph.csr, graph.n, threads, entries, stats.self_loops);
+    } else if (graph.has_list()) {
+        count_entries(graph.adj_list, graph.n, threads, entries, stats.self_loops);
+        entries -= static_cast<long long>(graph.adj_list.tombstones());
+    } else if (graph.has_matrix()) {
+        std::vector<long long> part_entries(resolve_threads(threads), 0), part_loops(resolve_threads(threads), 0);
+        parallel_for(graph.n, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+            for (std::size_t v = begin; v < end; v++) {
+                part_entries[id] += graph.adj_matrix.row_count(static_cast<int>(v));
+                part_loops[id] += graph.adj_matrix.test(static_cast<int>(v), static_cast<int>(v));
+            }
+        });
+        entries = std::accumulate(part_entries.begin(), part_entries.end(), 0LL);
+        stats.self_loops = std::accumulate(part_loops.begin(), part_loops.end(), 0LL);
+    }
+    stats.edges = (entries + stats.self_loops) / 2;
+    return stats;
+}
@@ -1,213 +1,668 @@
 // Created by IWOFLEUR on 19.10.2025
 
 #include "../../include/backend/graph_gen.h"
-
+#include "../../include/backend/graph_render.h"
+#include "../../include/backend/parallel.h"
+#include "../../include/backend/random.h"
+#include "../../include/core/cancellation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
 #include <chrono>
-#include <stack>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
-Graph create_graph(const int n, const double edgeProb, const double loopProb, const unsigned int seed) {
-    Graph graph;
-    graph.n = n;
+namespace {
+    using Edge = std::pair<int, int>;
 
-    // Формируем матрицу -> выводим -> все подряд
-    // Matrix memory allocating
-    graph.adj_matrix = new int*[n];
-    for (int i = 0; i < n; i++) {
-        graph.adj_matrix[i] = new int[n];
-        for (int j = 0; j < n; j++) {
-            graph.adj_matrix[i][j] = 0;
+    // Up-front reservation cap of the sparse generator (128 MiB of pairs), the vector grows past it
+    constexpr std::size_t max_reserved_edges = std::size_t{1} << 24;
+
+    double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Build the CSR from an undirected edge list (u <= v, loops as (u, u)).
+     * Degrees are counted first so rows are filled without reallocation;
+     * neighbours keep the order in which the edges were generated.
+     */
+    void build_csr(Graph& graph, const std::vector<Edge>& edges) {
+        const int n = graph.n;
+        std::vector<std::size_t> degree(n, 0);
+        for (const auto& [u, v] : edges) {
+            degree[u]++;
+            if (u != v) degree[v]++;
+        }
+
+        std::size_t total = 0;
+        for (const std::size_t d : degree) total += d;
+        if (total > std::numeric_limits<CSR::offset_type>::max()) {
+            throw std::length_error("Graph too large for CSR offsets, rebuild with CSR_64BIT_OFFSETS");
         }
+
+        // One arena reservation for both arrays
+        graph.arena->reserve((n + 1) * sizeof(CSR::offset_type) + total * sizeof(int) + 2 * Arena::alignment);
+        graph.csr.offsets = graph.allocate<CSR::offset_type>(n + 1);
+        for (int v = 0; v < n; v++) {
+            graph.csr.offsets[v + 1] = graph.csr.offsets[v] + static_cast<CSR::offset_type>(degree[v]);
+        }
+        graph.csr.neighbours = graph.allocate<int>(total);
+
+        // Reuse degree as the fill cursor of every CSR row
+        for (int v = 0; v < n; v++) degree[v] = graph.csr.offsets[v];
+        for (const auto& [u, v] : edges) {
+            graph.csr.neighbours[degree[u]++] = v;
+            if (u != v) graph.csr.neighbours[degree[v]++] = u;
+        }
+    }
+
+    /**
+     * Build the CSR from per-row upper neighbours (upper[i] holds j >= i, ascending).
+     * Every row of the result is lower part (sorted after a parallel scatter) followed by upper[i],
+     * exactly what build_csr produces for the same edges in row order.
+     */
+    void build_csr_from_rows(Graph& graph, const std::vector<std::vector<int>>& upper, const int threads) {
+        const int n = graph.n;
+        std::vector<std::size_t> lower(n, 0);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t i = begin; i < end; i++) {
+                for (const int j : upper[i]) {
+                    if (j != static_cast<int>(i)) std::atomic_ref(lower[j]).fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        std::size_t total = 0;
+        for (int v = 0; v < n; v++) total += lower[v] + upper[v].size();
+        if (total > std::numeric_limits<CSR::offset_type>::max()) {
+            throw std::length_error("Graph too large for CSR offsets, rebuild with CSR_64BIT_OFFSETS");
+        }
+
+        // One arena reservation for both arrays
+        graph.arena->reserve((n + 1) * sizeof(CSR::offset_type) + total * sizeof(int) + 2 * Arena::alignment);
+        graph.csr.offsets = graph.allocate<CSR::offset_type>(n + 1);
+        for (int v = 0; v < n; v++) {
+            graph.csr.offsets[v + 1] = graph.csr.offsets[v] + static_cast<CSR::offset_type>(lower[v] + upper[v].size());
+        }
+        graph.csr.neighbours = graph.allocate<int>(total);
+
+        // Upper parts are copied as is, lower parts are scattered through per-row cursors
+        std::vector<std::size_t> cursor(n);
+        for (int v = 0; v < n; v++) cursor[v] = graph.csr.offsets[v];
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t i = begin; i < end; i++) {
+                std::ranges::copy(upper[i], graph.csr.neighbours.begin() + static_cast<std::ptrdiff_t>(graph.csr.offsets[i] + lower[i]));
+                for (const int j : upper[i]) {
+                    if (j != static_cast<int>(i)) {
+                        graph.csr.neighbours[std::atomic_ref(cursor[j]).fetch_add(1, std::memory_order_relaxed)] = static_cast<int>(i);
+                    }
+                }
+            }
+        });
+
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                const auto first = graph.csr.neighbours.begin() + static_cast<std::ptrdiff_t>(graph.csr.offsets[v]);
+                std::sort(first, first + static_cast<std::ptrdiff_t>(lower[v]));
+            }
+        });
+    }
+
+    /**
+     * Per-row upper neighbours (j >= i, ascending, duplicates dropped) of an undirected
+     * edge list for build_csr_from_rows. Edges with a negative endpoint are skipped.
+     * Rows are filled through atomic cursors and sorted afterwards, so the result does
+     * not depend on the thread count.
+     */
+    std::vector<std::vector<int>> upper_rows(const int n, const std::vector<Edge>& edges, const int threads) {
+        std::vector<std::size_t> count(n, 0);
+        parallel_for(edges.size(), threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t e = begin; e < end; e++) {
+                const auto [u, v] = edges[e];
+                if (u >= 0 && v >= 0) std::atomic_ref(count[std::min(u, v)]).fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        std::vector<std::vector<int>> upper(n);
+        for (int v = 0; v < n; v++) upper[v].resize(count[v]);
+        std::ranges::fill(count, 0);
+        parallel_for(edges.size(), threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t e = begin; e < end; e++) {
+                const auto [u, v] = edges[e];
+                if (u < 0 || v < 0) continue;
+                const int low = std::min(u, v);
+                upper[low][std::atomic_ref(count[low]).fetch_add(1, std::memory_order_relaxed)] = std::max(u, v);
+            }
+        });
+
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                auto& row = upper[v];
+                std::ranges::sort(row);
+                row.erase(std::unique(row.begin(), row.end()), row.end());
+            }
+        });
+        return upper;
     }
 
-    // List initialization
-    graph.adj_list.resize(n);
+    /**
+     * Number of failures before the next success of a Bernoulli(p) sequence
+     * @param rng Random generator
+     * @param log_q log(1 - p), precomputed by the caller
+     */
+    template <typename Rng>
+    std::int64_t geometric_skip(Rng& rng, const double log_q) {
+        if (log_q == -std::numeric_limits<double>::infinity()) return 0;  // p == 1
+        if (log_q == 0.0) return std::numeric_limits<std::int64_t>::max(); // p == 0
+        const double skip = std::floor(std::log1p(-rng.uniform()) / log_q);
+        return skip >= static_cast<double>(std::numeric_limits<std::int64_t>::max())
+            ? std::numeric_limits<std::int64_t>::max()
+            : static_cast<std::int64_t>(skip);
+    }
+}
 
+std::uint64_t time_seed() {
     static unsigned int counter = 0;
     const auto now = std::chrono::high_resolution_clock::now();
     const auto nanos = std::chrono::time_point_cast<std::chrono::nanoseconds>(now).time_since_epoch().count();
-    unsigned int state = seed == 0 ? static_cast<unsigned int>(nanos) + counter++ : seed;
+    return static_cast<std::uint64_t>(nanos) + counter++;
+}
+
+Graph create_graph(const int n, const double edgeProb, const double loopProb, const unsigned int seed,
+                   const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    Graph graph(n, arena);
+
+    // Формируем матрицу -> выводим -> все подряд
+    // Matrix memory allocating (single zeroed bit-packed block), lists are derived on first use
+    graph.adj_matrix = graph.allocate_matrix();
 
+    unsigned int state = seed == 0 ? static_cast<unsigned int>(time_seed()) : seed;
+
+    progress_begin(n);
     for (int i = 0; i < n; i++) {
+        check_cancelled();
+        progress_set(i);
         for (int j = i; j < n; j++) {
             state = (state * 1664525 + 1013904223) & 0x7fffffff;
             const int rand_value = static_cast<int>(state) % 100;
 
             if (i == j) {
                 if (rand_value < static_cast<int>(loopProb * 100)) {
-                    graph.adj_matrix[i][j] = 1;
-                    graph.adj_list[i].push_back(i);
+                    graph.adj_matrix.set(i, i);
                 }
             } else {
                 if (rand_value < static_cast<int>(edgeProb * 100)) {
-                    graph.adj_matrix[i][j] = graph.adj_matrix[j][i] = 1;
-                    graph.adj_list[i].push_back(j);
-                    graph.adj_list[j].push_back(i);
+                    graph.adj_matrix.set(i, j);
+                    graph.adj_matrix.set(j, i);
                 }
             }
         }
     }
 
+    graph.build_ms.generate = elapsed_ms(start);
     return graph;
 }
 
-void print_matrix(int **matrix, const int rows, const int cols, const char *name) {
-    if (!matrix || rows <= 0 || cols <= 0) {
-        std::cout << "Invalid matrix parameters" << std::endl;
-        return;
+Graph create_graph_sparse(const int n, const double edgeProb, const double loopProb, const std::uint64_t seed,
+                          const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    Graph graph(n, arena);
+
+    Xoshiro256 rng(seed == 0 ? time_seed() : seed);
+    const double log_edge = std::log1p(-std::clamp(edgeProb, 0.0, 1.0));
+    const double log_loop = std::log1p(-std::clamp(loopProb, 0.0, 1.0));
+
+    std::vector<Edge> edges;
+    // The expected count is only a hint: a huge n with moderate p must fail while drawing, not here
+    const double expected = edgeProb * n * (n - 1.0) / 2.0 + loopProb * n + 16;
+    edges.reserve(static_cast<std::size_t>(std::min(expected, static_cast<double>(max_reserved_edges))));
+
+    const auto add_edge = [&](const int u, const int v) {
+        edges.emplace_back(u, v);
+    };
+
+    // Loops walk the diagonal with their own gaps, emitted once a vertex has
+    // all its lower neighbours so every list comes out sorted like create_graph
+    std::int64_t next_loop = geometric_skip(rng, log_loop);
+    const auto flush_loops = [&](const std::int64_t upto) {
+        while (next_loop < upto) {
+            add_edge(static_cast<int>(next_loop), static_cast<int>(next_loop));
+            const std::int64_t skip = geometric_skip(rng, log_loop);
+            next_loop = skip >= n ? n : next_loop + 1 + skip;
+        }
+    };
+
+    // Walk the strict lower triangle row by row (v = larger endpoint, w < v)
+    std::int64_t v = 1;
+    std::int64_t w = -1;
+    progress_begin(n);
+    flush_loops(std::min<std::int64_t>(1, n));
+    while (v < n) {
+        const std::int64_t skip = geometric_skip(rng, log_edge);
+        if (skip >= static_cast<std::int64_t>(n) * n) {
+            break;
+        }
+        w += 1 + skip;
+        while (w >= v && v < n) {
+            w -= v;
+            v++;
+            flush_loops(std::min<std::int64_t>(v, n));
+            if (v % 1024 == 0) {
+                check_cancelled();
+                progress_set(v);
+            }
+        }
+        if (v < n) add_edge(static_cast<int>(w), static_cast<int>(v));
     }
+    flush_loops(n);
 
-    std::cout << name << ":" << std::endl;
+    build_csr(graph, edges);
 
-    // Calculate maximum width needed for numbers
-    int max_num_width = 1;
-    for (int i = 0; i < rows; i++) {
-        for (int j = 0; j < cols; j++) {
-            if (const int num_width = static_cast<int>(std::to_string(matrix[i][j]).length()); num_width > max_num_width) {
-                max_num_width = num_width;
+    graph.build_ms.generate = elapsed_ms(start);
+    return graph;
+}
+
+Graph create_graph_parallel(const int n, const double edgeProb, const double loopProb, const std::uint64_t seed,
+                            const int threads, const bool sparse, const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    Graph graph(n, arena);
+
+    const double log_edge = std::log1p(-std::clamp(edgeProb, 0.0, 1.0));
+    // Dense rows compare raw 32-bit draws, four pair tests per Philox block
+    const auto edge_threshold = static_cast<std::uint64_t>(std::clamp(edgeProb, 0.0, 1.0) * 0x1.0p32);
+    std::vector<std::vector<int>> upper(n);
+
+    // Small grain: row i costs n - i pair tests in dense mode
+    progress_begin(n);
+    parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        if (cancel_requested()) return;
+        progress_add(static_cast<std::int64_t>(end - begin));
+        for (std::size_t row = begin; row < end; row++) {
+            const int i = static_cast<int>(row);
+            PhiloxStream rng(seed, row);
+            auto& out = upper[row];
+
+            if (rng.uniform() < loopProb) out.push_back(i);
+            if (sparse) {
+                for (std::int64_t j = i;;) {
+                    const std::int64_t skip = geometric_skip(rng, log_edge);
+                    if (skip >= n - j - 1) break;
+                    j += 1 + skip;
+                    out.push_back(static_cast<int>(j));
+                }
+            } else {
+                for (int j = i + 1; j < n; j++) {
+                    if (rng.next32() < edge_threshold) out.push_back(j);
+                }
             }
         }
-    }
+    }, 16);
+    check_cancelled();
 
-    // Calculate width for row indices
-    const int row_index_width = static_cast<int>(std::to_string(rows - 1).length());
-    max_num_width = std::max(max_num_width, 2);
+    build_csr_from_rows(graph, upper, threads);
 
-    // Print column headers with dynamic spacing
-    std::cout << std::setw(row_index_width + 2) << " ";
-    for (int j = 0; j < cols; j++) {
-        std::cout << std::setw(max_num_width + 1) << j;
-    }
-    std::cout << std::endl;
+    graph.build_ms.generate = elapsed_ms(start);
+    return graph;
+}
 
-    // Print separator line
-    std::cout << std::setw(row_index_width + 2) << " " << "+";
-    for (int j = 0; j < cols; j++) {
-        std::cout << std::string(max_num_width + 1, '-');
-    }
-    std::cout << std::endl;
+Graph create_graph_rmat(const int n, const double degree, const std::uint64_t seed, const int threads,
+                        const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    Graph graph(n, arena);
+
+    // Graph500 quadrant probabilities as 32-bit thresholds: a | b | c | d
+    constexpr auto a = static_cast<std::uint64_t>(0.57 * 0x1.0p32);
+    constexpr auto ab = static_cast<std::uint64_t>(0.76 * 0x1.0p32);
+    constexpr auto abc = static_cast<std::uint64_t>(0.95 * 0x1.0p32);
+    const int scale = std::max(1, static_cast<int>(std::bit_width(static_cast<unsigned>(std::max(1, n - 1)))));
+    std::vector<Edge> edges(static_cast<std::size_t>(std::max(0.0, degree) * n / 2));
+
+    // Edge e draws from its own stream, pairs that fall outside [0, n) are drawn again
+    progress_begin(static_cast<std::int64_t>(edges.size()));
+    parallel_for(edges.size(), threads, [&](const std::size_t begin, const std::size_t end, int) {
+        if (cancel_requested()) return;
+        progress_add(static_cast<std::int64_t>(end - begin));
+        for (std::size_t e = begin; e < end; e++) {
+            PhiloxStream rng(seed, e);
+            int u, v;
+            do {
+                u = v = 0;
+                for (int level = 0; level < scale; level++) {
+                    const std::uint32_t draw = rng.next32();
+                    u = u << 1 | (draw >= ab);
+                    v = v << 1 | ((draw >= a && draw < ab) || draw >= abc);
+                }
+            } while (u >= n || v >= n);
+            edges[e] = u == v ? Edge{-1, -1} : Edge{u, v};
+        }
+    });
+    check_cancelled();
+    build_csr_from_rows(graph, upper_rows(n, edges, threads), threads);
+
+    graph.build_ms.generate = elapsed_ms(start);
+    return graph;
+}
 
-    // Print matrix rows with borders
-    for (int i = 0; i < rows; i++) {
-        std::cout << std::setw(row_index_width) << i << " |";
-        for (int j = 0; j < cols; j++) {
-            std::cout << std::setw(max_num_width + 1) << matrix[i][j];
+Graph create_graph_ba(const int n, const int attach, const std::uint64_t seed, const int threads,
+                      const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    Graph graph(n, arena);
+
+    // Edge slot i belongs to vertex i / attach. Its target is a uniform pick among the endpoints
+    // of all earlier slots: an even pick is the source of slot r / 2 (known), an odd one is the
+    // target of slot r / 2, resolved the same way. Slots of vertex 0 point to 0.
+    const std::size_t k = static_cast<std::size_t>(std::max(1, attach));
+    const auto target = [&](std::size_t slot) {
+        while (slot >= k) {
+            PhiloxStream rng(seed, slot);
+            const std::size_t pick = rng.next() % (2 * slot);
+            if (pick % 2 == 0) return static_cast<int>(pick / 2 / k);
+            slot = pick / 2;
         }
-        std::cout << std::endl;
-    }
+        return 0;
+    };
+
+    std::vector<Edge> edges(n > 1 ? (static_cast<std::size_t>(n) - 1) * k : 0);
+    progress_begin(static_cast<std::int64_t>(edges.size()));
+    parallel_for(edges.size(), threads, [&](const std::size_t begin, const std::size_t end, int) {
+        if (cancel_requested()) return;
+        progress_add(static_cast<std::int64_t>(end - begin));
+        for (std::size_t e = begin; e < end; e++) {
+            const std::size_t slot = e + k;
+            const int source = static_cast<int>(slot / k);
+            const int t = target(slot);
+            edges[e] = t == source ? Edge{-1, -1} : Edge{t, source};
+        }
+    });
+    check_cancelled();
+    build_csr_from_rows(graph, upper_rows(n, edges, threads), threads);
+
+    graph.build_ms.generate = elapsed_ms(start);
+    return graph;
 }
 
-void delete_graph(Graph& graph, const int n) {
-    for (int i = 0; i < n; i++) {
-        delete[] graph.adj_matrix[i];
-    }
-    delete[] graph.adj_matrix;
-    graph.adj_matrix = nullptr;
-    graph.n = 0;
-    graph.adj_list.resize(0);
+Graph create_graph_grid(const int n, const int dimensions, const int threads, const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    Graph graph(n, arena);
+
+    // Smallest side that holds n vertices, the last row (and layer) may be partial
+    int side = 1;
+    while (dimensions == 3 ? static_cast<long long>(side) * side * side < n : static_cast<long long>(side) * side < n) side++;
+    const long long layer = static_cast<long long>(side) * side;
+
+    std::vector<std::vector<int>> upper(n);
+    parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        for (std::size_t row = begin; row < end; row++) {
+            const long long v = static_cast<long long>(row);
+            auto& out = upper[row];
+            if ((v + 1) % side != 0 && v + 1 < n) out.push_back(static_cast<int>(v + 1));
+            if (v % layer + side < layer && v + side < n) out.push_back(static_cast<int>(v + side));
+            if (dimensions == 3 && v + layer < n) out.push_back(static_cast<int>(v + layer));
+        }
+    });
+    build_csr_from_rows(graph, upper, threads);
+
+    graph.build_ms.generate = elapsed_ms(start);
+    return graph;
 }
 
-void print_list(const std::vector<std::vector<int> > &list, const char* name) {
-    std::cout << name << ":" << std::endl;
-    for (int i = 0; i < list.size(); i++) {
-        std::cout << i << ": ";
-        for (const int neigh : list[i]) {
-            std::cout << neigh << " ";
+Graph create_graph_geometric(const int n, const double radius, const std::uint64_t seed, const int threads,
+                             const ArenaOptions arena) {
+    const auto start = std::chrono::steady_clock::now();
+    Graph graph(n, arena);
+
+    std::vector<double> x(n), y(n);
+    parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        for (std::size_t v = begin; v < end; v++) {
+            PhiloxStream rng(seed, v);
+            x[v] = rng.uniform();
+            y[v] = rng.uniform();
         }
-        std::cout << std::endl;
-    }
+    });
+
+    // Cells at least radius wide, so every neighbour is in one of the 3 x 3 cells around a point
+    const int cells = std::clamp(static_cast<int>(1.0 / std::max(radius, 1e-9)), 1,
+                                 std::max(1, static_cast<int>(std::sqrt(static_cast<double>(n)))));
+    const auto cell_of = [&](const double coordinate) { return std::min(cells - 1, static_cast<int>(coordinate * cells)); };
+    std::vector<int> cell_start(static_cast<std::size_t>(cells) * cells + 1, 0), by_cell(n);
+    for (int v = 0; v < n; v++) cell_start[cell_of(y[v]) * cells + cell_of(x[v]) + 1]++;
+    for (std::size_t c = 1; c < cell_start.size(); c++) cell_start[c] += cell_start[c - 1];
+    std::vector<int> cursor(cell_start.begin(), cell_start.end() - 1);
+    for (int v = 0; v < n; v++) by_cell[cursor[cell_of(y[v]) * cells + cell_of(x[v])]++] = v;
+
+    const double radius_sq = radius * radius;
+    std::vector<std::vector<int>> upper(n);
+    progress_begin(n);
+    parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+        if (cancel_requested()) return;
+        progress_add(static_cast<std::int64_t>(end - begin));
+        for (std::size_t row = begin; row < end; row++) {
+            const int v = static_cast<int>(row);
+            const int cx = cell_of(x[v]), cy = cell_of(y[v]);
+            auto& out = upper[row];
+            for (int ny = std::max(0, cy - 1); ny <= std::min(cells - 1, cy + 1); ny++) {
+                for (int nx = std::max(0, cx - 1); nx <= std::min(cells - 1, cx + 1); nx++) {
+                    for (int i = cell_start[ny * cells + nx]; i < cell_start[ny * cells + nx + 1]; i++) {
+                        const int w = by_cell[i];
+                        const double dx = x[w] - x[v], dy = y[w] - y[v];
+                        if (w > v && dx * dx + dy * dy <= radius_sq) out.push_back(w);
+                    }
+                }
+            }
+            std::ranges::sort(out);
+        }
+    });
+    check_cancelled();
+    build_csr_from_rows(graph, upper, threads);
+
+    graph.build_ms.generate = elapsed_ms(start);
+    return graph;
 }
 
-void DFS(const int v, const Graph &graph, bool *visited, const bool is_recursive) {
-    if (is_recursive == true) {
-        visited[v] = true;
+void print_matrix(const BitMatrix &matrix, const char *name) {
+    render_matrix(matrix, name);
+}
+
+void delete_graph(Graph& graph) {
+    // Every array holds the arena, dropping them together unmaps its blocks in one go
+    graph = Graph();
+}
+
+void print_list(const AdjacencyList &list, const char* name) {
+    render_list(list, name);
+}
 
-        std::cout << std::setw(3) << v << " ";
+void Traversal::reset(const int n) {
+    order.clear();
+    order.reserve(n);
+    // Entries of unvisited vertices are stale, no need to clear them
+    if (parent.size() != static_cast<size_t>(n)) parent.resize(n, -1);
+}
 
-        for (int i = 0; i < graph.n; i++) {
-            if (graph.adj_matrix[v][i] == 1 && visited[i] == false) DFS(i, graph, visited, is_recursive);
+namespace {
+    constexpr int word_bits = BitMatrix::word_bits;
+
+    // Above this many vertices the recursive methods run on the explicit stack instead:
+    // the visit order is identical and a deep component cannot overflow the thread stack
+    constexpr int max_recursive_vertices = 1 << 16;
+
+    void visit(const int v, const int from, VisitedSet &visited, Traversal &out) {
+        visited.set(v);
+        out.order.push_back(v);
+        out.parent[v] = from;
+        // A background job polls for cancellation every 4096 visits
+        if ((out.order.size() & 4095) == 0) {
+            check_cancelled();
+            progress_set(static_cast<std::int64_t>(out.order.size()));
         }
-    } else {
-        std::stack<int> stack;
-        stack.push(v);
+    }
 
-        while (!stack.empty()) {
-            const int current = stack.top();
-            stack.pop();
+    void dfs_matrix_recursive(const int v, const int from, const Graph &graph, VisitedSet &visited, Traversal &out) {
+        visit(v, from, visited, out);
+
+        // Scan the row a word at a time, only unvisited neighbours survive the mask
+        const auto words = static_cast<int>(graph.adj_matrix.row_words());
+        const BitMatrix::word_t* row = graph.adj_matrix.row(v);
+        for (int w = 0; w < words; w++) {
+            BitMatrix::word_t candidates = row[w] & ~visited.word(w);
+            while (candidates != 0) {
+                dfs_matrix_recursive(w * word_bits + std::countr_zero(candidates), v, graph, visited, out);
+                // The recursion may have visited more vertices of this word
+                candidates &= ~visited.word(w);
+            }
+        }
+    }
 
-            if (visited[current] == false) {
-                visited[current] = true;
-                std::cout << std::setw(3) << current << " ";
+    // One (vertex, first column not scanned yet) frame per tree level, each row scan
+    // resumes at its cursor, so the whole traversal reads every row word once
+    void dfs_matrix_iterative(const int v, const Graph &graph, TraversalWorkspace &workspace, Traversal &out) {
+        const auto words = static_cast<int>(graph.adj_matrix.row_words());
+        VisitedSet &visited = workspace.visited;
+        auto &stack = workspace.stack;
+        stack.clear();
+        visit(v, -1, visited, out);
+        stack.emplace_back(v, 0);
 
-                for (int i = graph.n - 1; i >= 0; i--) {
-                    if (graph.adj_matrix[current][i] == 1 && visited[i] == false) {
-                        stack.push(i);
-                    }
-                }
+        while (!stack.empty()) {
+            auto &[current, cursor] = stack.back();
+            const BitMatrix::word_t* row = graph.adj_matrix.row(current);
+            int next = -1;
+            for (int w = cursor / word_bits; w < words && next < 0; w++) {
+                BitMatrix::word_t candidates = row[w] & ~visited.word(w);
+                if (w == cursor / word_bits) candidates &= ~BitMatrix::word_t{0} << (cursor % word_bits);
+                if (candidates != 0) next = w * word_bits + std::countr_zero(candidates);
+            }
+
+            if (next < 0) {
+                stack.pop_back();
+                continue;
             }
+            cursor = next + 1;
+            const int from = current;
+            visit(next, from, visited, out);
+            stack.emplace_back(next, 0);
         }
     }
 }
 
-void prep(const Graph& graph, const int vert, const bool is_recursive) {
-    const auto visited = new bool[graph.n];
-    for (int i = 0; i < graph.n; i++) {
-        visited[i] = false;
-    }
+void DFS(const int v, const Graph &graph, TraversalWorkspace &workspace, const bool is_recursive, Traversal &out) {
+    if (is_recursive == true && graph.n <= max_recursive_vertices) dfs_matrix_recursive(v, -1, graph, workspace.visited, out);
+    else dfs_matrix_iterative(v, graph, workspace, out);
+}
+
+void prep(const Graph& graph, const int vert, const bool is_recursive, Traversal &out, TraversalWorkspace &workspace) {
+    out.reset(graph.n);
+    workspace.visited.prepare(graph.n);
+    progress_begin(graph.n);
     if (is_recursive == true) {
-        for (int v = vert; v < graph.n; v++) {
-            if (visited[v] == false) {
-                DFS(v, graph, visited, is_recursive);
+        // Restart roots follow the original ids, so a reordered graph sweeps the same vertices
+        for (int o = graph.ids.to_original(vert); o < graph.n; o++) {
+            const int v = graph.ids.to_current(o);
+            if (!workspace.visited.test(v)) {
+                DFS(v, graph, workspace, is_recursive, out);
             }
         }
-    } else DFS(vert, graph, visited, is_recursive);
-
-    std::cout << std::endl;
-    delete[] visited;
+    } else DFS(vert, graph, workspace, is_recursive, out);
 }
 
-void DFS_list(const int v, const Graph &graph, bool *visited, const bool is_recursive) {
-    if (is_recursive == true) {
-        visited[v] = true;
-        std::cout << std::setw(3) << v << " ";
+namespace {
+    // Shared by the adj_list and CSR paths, Adjacency[v] yields an indexable range
+    template <typename Adjacency>
+    void dfs_adjacency_recursive(const int v, const int from, const Adjacency& adjacency, VisitedSet &visited, Traversal &out) {
+        visit(v, from, visited, out);
 
-        for (const int neighbour : graph.adj_list[v]) {
-            if (visited[neighbour] == false) {
-                DFS_list(neighbour, graph, visited, is_recursive);
+        for (const int neighbour : adjacency[v]) {
+            if (!visited.test(neighbour)) {
+                dfs_adjacency_recursive(neighbour, v, adjacency, visited, out);
             }
         }
-    } else {
-        std::stack<int> stack;
-        stack.push(v);
+    }
+
+    // Explicit-stack twin of dfs_adjacency_recursive: one (vertex, next neighbour index)
+    // frame per tree level, so the stack is O(depth), nothing is pushed twice and the
+    // visit order matches the recursion exactly
+    template <typename Adjacency>
+    void dfs_adjacency_iterative(const int v, const Adjacency& adjacency, TraversalWorkspace &workspace, Traversal &out) {
+        VisitedSet &visited = workspace.visited;
+        auto &stack = workspace.stack;
+        stack.clear();
+        visit(v, -1, visited, out);
+        stack.emplace_back(v, 0);
 
         while (!stack.empty()) {
-            const int current = stack.top();
-            stack.pop();
-            if (visited[current] == false) {
-                visited[current] = true;
-                std::cout << std::setw(3) << current << " ";
-
-                const auto& neighbours = graph.adj_list[current];
-                for (int i = static_cast<int>(neighbours.size()) - 1; i >= 0; i--) {
-                    if (int neighbour = neighbours[i]; visited[neighbour] == false) stack.push(neighbour);
-                }
+            auto &[current, cursor] = stack.back();
+            const auto neighbours = adjacency[current];
+            const auto degree = static_cast<int>(neighbours.size());
+            while (cursor < degree && visited.test(neighbours[cursor])) cursor++;
+
+            if (cursor == degree) {
+                stack.pop_back();
+                continue;
             }
+            const int next = neighbours[cursor++];
+            const int from = current;
+            visit(next, from, visited, out);
+            stack.emplace_back(next, 0);
         }
     }
-}
 
-void prep_list(const Graph &graph, const int vert, const bool is_recursive) {
-    const auto visited = new bool[graph.n];
-    for (int i = 0; i < graph.n; i++) {
-        visited[i] = false;
+    template <typename Adjacency>
+    void dfs_adjacency(const int v, const Adjacency& adjacency, const int n, TraversalWorkspace &workspace,
+                       const bool is_recursive, Traversal &out) {
+        if (is_recursive == true && n <= max_recursive_vertices) dfs_adjacency_recursive(v, -1, adjacency, workspace.visited, out);
+        else dfs_adjacency_iterative(v, adjacency, workspace, out);
     }
-    if (is_recursive == true) {
-        for (int v = vert; v < graph.n; v++) {
-            if (visited[v] == false) {
-                DFS_list(v, graph, visited, is_recursive);
+
+    template <typename Adjacency>
+    void prep_adjacency(const Adjacency& adjacency, const int n, const VertexIds& ids, const int vert,
+                        const bool is_recursive, Traversal &out, TraversalWorkspace &workspace) {
+        out.reset(n);
+        workspace.visited.prepare(n);
+        progress_begin(n);
+        if (is_recursive == true) {
+            // Same root order as prep
+            for (int o = ids.to_original(vert); o < n; o++) {
+                const int v = ids.to_current(o);
+                if (!workspace.visited.test(v)) {
+                    dfs_adjacency(v, adjacency, n, workspace, is_recursive, out);
+                }
             }
-        }
-    } else DFS_list(vert, graph, visited, is_recursive);
+        } else dfs_adjacency(vert, adjacency, n, workspace, is_recursive, out);
+    }
+}
+
+void DFS_list(const int v, const Graph &graph, TraversalWorkspace &workspace, const bool is_recursive, Traversal &out) {
+    dfs_adjacency(v, graph.adj_list, graph.n, workspace, is_recursive, out);
+}
 
-    std::cout << std::endl;
-    delete[] visited;
+void prep_list(const Graph &graph, const int vert, const bool is_recursive, Traversal &out, TraversalWorkspace &workspace) {
+    prep_adjacency(graph.adj_list, graph.n, graph.ids, vert, is_recursive, out, workspace);
+}
+
+void DFS_csr(const int v, const Graph &graph, TraversalWorkspace &workspace, const bool is_recursive, Traversal &out) {
+    dfs_adjacency(v, graph.csr, graph.n, workspace, is_recursive, out);
+}
+
+void prep_csr(const Graph &graph, const int vert, const bool is_recursive, Traversal &out, TraversalWorkspace &workspace) {
+    prep_adjacency(graph.csr, graph.n, graph.ids, vert, is_recursive, out, workspace);
+}
+
+void print_traversal(const Traversal &traversal) {
+    // Same layout as the old per-vertex "setw(3) << v << ' '", formatted in one buffer
+    std::string text;
+    text.reserve(traversal.order.size() * 5 + 1);
+    char cell[16];
+    for (const int v : traversal.order) {
+        const auto [end, ec] = std::to_chars(cell, cell + sizeof(cell), v);
+        for (auto pad = end - cell; pad < 3; pad++) text.push_back(' ');
+        text.append(cell, end);
+        text.push_back(' ');
+    }
+    text.push_back('\n');
+    std::cout << text << std::flush;
 }
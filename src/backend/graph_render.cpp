@@ -0,0 +1,203 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/graph_render.h"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+OutputBuffer::OutputBuffer(std::ostream &os, const std::size_t chunk) : out(os), chunk_size(chunk) {
+    // Headroom so a single put() never reallocates before the flush check
+    buffer.reserve(chunk_size + 256);
+}
+
+OutputBuffer::~OutputBuffer() {
+    flush();
+}
+
+void OutputBuffer::put(const std::string_view text) {
+    buffer.append(text);
+    if (buffer.size() >= chunk_size) flush();
+}
+
+void OutputBuffer::put_repeat(const char c, const std::size_t count) {
+    buffer.append(count, c);
+    if (buffer.size() >= chunk_size) flush();
+}
+
+void OutputBuffer::put_int(const long long value, const int width) {
+    char digits[24];
+    const auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+    if (const auto length = static_cast<int>(end - digits); length < width) {
+        buffer.append(static_cast<std::size_t>(width - length), ' ');
+    }
+    buffer.append(digits, end);
+    if (buffer.size() >= chunk_size) flush();
+}
+
+void OutputBuffer::flush() {
+    if (buffer.empty()) return;
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    out.flush();
+    buffer.clear();
+}
+
+namespace {
+    int digits(const int value) {
+        int count = 1;
+        for (int v = value; v >= 10; v /= 10) count++;
+        return count;
+    }
+
+    // Clamp [begin, end) to [0, limit), end < 0 means limit
+    void clamp_range(int &begin, int &end, const int limit) {
+        if (end < 0 || end > limit) end = limit;
+        begin = std::clamp(begin, 0, end);
+    }
+
+    template <typename Adjacency>
+    void render_adjacency(const Adjacency &adjacency, const int n, const char *name, int begin, int end, std::ostream &os) {
+        clamp_range(begin, end, n);
+        OutputBuffer out(os);
+        out.put(name);
+        out.put(":\n");
+        for (int i = begin; i < end; i++) {
+            out.put_int(i);
+            out.put(": ");
+            for (const int neigh : adjacency[i]) {
+                out.put_int(neigh);
+                out.put(' ');
+            }
+            out.put('\n');
+        }
+    }
+}
+
+void render_matrix(const BitMatrix &matrix, const char *name, const RenderWindow &window, const MatrixStyle style,
+                   std::ostream &os) {
+    if (matrix.empty()) {
+        os << "Invalid matrix parameters" << std::endl;
+        return;
+    }
+
+    int row_begin = window.row_begin, row_end = window.row_end;
+    int col_begin = window.col_begin, col_end = window.col_end;
+    clamp_range(row_begin, row_end, matrix.rows());
+    clamp_range(col_begin, col_end, matrix.cols());
+    if (row_begin == row_end || col_begin == col_end) {
+        os << "Empty window" << std::endl;
+        return;
+    }
+
+    OutputBuffer out(os);
+    out.put(name);
+    out.put(":\n");
+
+    const int row_index_width = digits(row_end - 1);
+
+    if (style == MatrixStyle::Bits) {
+        for (int i = row_begin; i < row_end; i++) {
+            const BitMatrix::word_t *row = matrix.row(i);
+            out.put_int(i, row_index_width);
+            out.put(" |");
+            for (int j = col_begin; j < col_end; j++) {
+                out.put((row[j / BitMatrix::word_bits] >> (j % BitMatrix::word_bits) & 1u) ? '1' : '0');
+            }
+            out.put('\n');
+        }
+        return;
+    }
+
+    // Cells are 0/1, the column width only depends on the largest column index
+    const int cell_width = std::max(digits(col_end - 1), 2) + 1;
+    const std::string one = std::string(cell_width - 1, ' ') + '1';
+    const std::string zero = std::string(cell_width - 1, ' ') + '0';
+
+    // Column headers
+    out.put_repeat(' ', row_index_width + 2);
+    for (int j = col_begin; j < col_end; j++) {
+        out.put_int(j, cell_width);
+    }
+    out.put('\n');
+
+    // Separator line
+    out.put_repeat(' ', row_index_width + 2);
+    out.put('+');
+    out.put_repeat('-', static_cast<std::size_t>(cell_width) * (col_end - col_begin));
+    out.put('\n');
+
+    // Rows with borders
+    for (int i = row_begin; i < row_end; i++) {
+        const BitMatrix::word_t *row = matrix.row(i);
+        out.put_int(i, row_index_width);
+        out.put(" |");
+        for (int j = col_begin; j < col_end; j++) {
+            out.put((row[j / BitMatrix::word_bits] >> (j % BitMatrix::word_bits) & 1u) ? one : zero);
+        }
+        out.put('\n');
+    }
+}
+
+void render_list(const AdjacencyList &list, const char *name, const int begin, const int end,
+                 std::ostream &os) {
+    render_adjacency(list, static_cast<int>(list.size()), name, begin, end, os);
+}
+
+void render_list(const CSR &csr, const char *name, const int begin, const int end, std::ostream &os) {
+    render_adjacency(csr, csr.vertices(), name, begin, end, os);
+}
+
+bool export_density_map(const CSR &csr, const std::string &path, const int size) {
+    const int n = csr.vertices();
+    if (n <= 0 || size <= 0) return false;
+
+    const bool bitmap = path.ends_with(".pbm");
+    if (!bitmap && !path.ends_with(".pgm")) return false;
+
+    const int side = std::min(size, n);
+    const auto bucket = [&](const int v) {
+        return static_cast<int>(static_cast<long long>(v) * side / n);
+    };
+
+    // Vertices per bucket, the cell area is the product of its row and column bucket sizes
+    std::vector<long long> span(side, 0);
+    for (int v = 0; v < n; v++) span[bucket(v)]++;
+
+    std::vector<long long> counts(static_cast<std::size_t>(side) * side, 0);
+    for (int v = 0; v < n; v++) {
+        const std::size_t row = static_cast<std::size_t>(bucket(v)) * side;
+        for (const int u : csr[v]) counts[row + bucket(u)]++;
+    }
+
+    std::string image;
+    if (bitmap) {
+        image = "P4\n" + std::to_string(side) + " " + std::to_string(side) + "\n";
+        const std::size_t row_bytes = (static_cast<std::size_t>(side) + 7) / 8;
+        const std::size_t header = image.size();
+        image.resize(header + row_bytes * side, '\0');
+        for (int r = 0; r < side; r++) {
+            for (int c = 0; c < side; c++) {
+                if (counts[static_cast<std::size_t>(r) * side + c] != 0) {
+                    image[header + r * row_bytes + c / 8] |= static_cast<char>(0x80 >> (c % 8));
+                }
+            }
+        }
+    } else {
+        image = "P5\n" + std::to_string(side) + " " + std::to_string(side) + "\n255\n";
+        image.reserve(image.size() + static_cast<std::size_t>(side) * side);
+        for (int r = 0; r < side; r++) {
+            for (int c = 0; c < side; c++) {
+                const long long area = span[r] * span[c];
+                const long long filled = counts[static_cast<std::size_t>(r) * side + c];
+                image.push_back(static_cast<char>(255 - filled * 255 / area));
+            }
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    file.write(image.data(), static_cast<std::streamsize>(image.size()));
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,162 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/graph_update.h"
+#include "../../include/backend/components.h"
+#include "../../include/backend/graph_convert.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    void check_vertex(const Graph& graph, const int v) {
+        if (v < 0 || v >= graph.n) {
+            throw std::out_of_range("vertex " + std::to_string(v) + " out of range [0, " + std::to_string(graph.n) + ")");
+        }
+    }
+
+    /**
+     * Copy the live rows (and the matrix) into a fresh arena, releasing every abandoned slot.
+     * The CSR handle moves over unchanged: updates drop it, but a shared graph without a
+     * list still converts from it.
+     */
+    void compact_storage(Graph& graph) {
+        graph.adj_list.compact();
+        std::vector<std::uint32_t> degree(graph.n);
+        std::size_t entries = 0;
+        for (int v = 0; v < graph.n && graph.has_list(); v++) {
+            degree[v] = static_cast<std::uint32_t>(graph.adj_list[v].size());
+            entries += degree[v];
+        }
+
+        Graph fresh(graph.n, graph.arena->options());
+        fresh.arena->reserve(graph.n * sizeof(std::uint64_t) * 2 + entries * sizeof(int) + graph.adj_matrix.bytes()
+                             + 3 * Arena::alignment);
+        if (graph.has_list()) {
+            fresh.adj_list = AdjacencyList(graph.n, fresh.arena);
+            fresh.adj_list.layout(degree);
+            for (int v = 0; v < graph.n; v++) fresh.adj_list.assign(v, graph.adj_list[v]);
+        }
+        if (graph.has_matrix()) {
+            fresh.adj_matrix = fresh.allocate_matrix();
+            std::memcpy(fresh.adj_matrix.row(0), graph.adj_matrix.row(0), graph.adj_matrix.bytes());
+        }
+        fresh.csr = std::move(graph.csr);
+        fresh.build_ms = graph.build_ms;
+        fresh.connectivity = std::move(graph.connectivity);
+        fresh.ids = std::move(graph.ids);
+        graph = std::move(fresh);
+    }
+
+    // Make adj_list the representation being edited and drop the CSR it will diverge from
+    void begin_update(Graph& graph, const int threads) {
+        // A clone writes to its own copy, the graphs it was shared with keep the old storage
+        if (graph.sharers() > 0) compact_storage(graph);
+        if (graph.has_list()) {
+        } else if (graph.n > 0) {
+            ensure_list(graph, threads);
+        } else {
+            graph.adj_list = AdjacencyList(0, graph.arena);
+        }
+        graph.csr.clear();
+        graph.build_ms.csr = 0;
+    }
+
+    bool has_edge(const Graph& graph, const int u, const int v) {
+        if (graph.has_matrix()) return graph.adj_matrix.test(u, v);
+        const auto row_u = graph.adj_list[u];
+        const auto row_v = graph.adj_list[v];
+        return row_u.size() <= row_v.size() ? std::ranges::find(row_u, v) != row_u.end()
+                                            : std::ranges::find(row_v, u) != row_v.end();
+    }
+
+    void end_update(Graph& graph) {
+        const std::size_t live = graph.adj_list.bytes() + graph.adj_matrix.bytes();
+        if (graph.arena->used_bytes() > 2 * live + Arena::min_block_bytes) compact_storage(graph);
+    }
+}
+
+Graph clone_graph(Graph &graph) {
+    // Shared rows are never written, so sweep the source's tombstones before handing them out
+    graph.adj_list.compact();
+    Graph copy(graph.n, graph.arena->options());
+    copy.arena = graph.arena;
+    copy.adj_matrix = graph.adj_matrix.share();
+    copy.adj_list = graph.adj_list.share();
+    copy.csr = graph.csr.share();
+    copy.build_ms = graph.build_ms;
+    copy.connectivity = graph.connectivity;
+    copy.ids = graph.ids;
+    copy.storage = graph.storage;
+    return copy;
+}
+
+bool add_edge(Graph &graph, const int u, const int v, const int threads) {
+    check_vertex(graph, u);
+    check_vertex(graph, v);
+    begin_update(graph, threads);
+    if (has_edge(graph, u, v)) return false;
+
+    graph.adj_list.push_back(u, v);
+    if (u != v) graph.adj_list.push_back(v, u);
+    if (graph.has_matrix()) {
+        graph.adj_matrix.set(u, v);
+        graph.adj_matrix.set(v, u);
+    }
+    if (!graph.connectivity.empty()) graph.connectivity.unite(u, v);
+    end_update(graph);
+    return true;
+}
+
+bool remove_edge(Graph &graph, const int u, const int v, const int threads) {
+    check_vertex(graph, u);
+    check_vertex(graph, v);
+    begin_update(graph, threads);
+    if (!graph.adj_list.remove(u, v)) return false;
+
+    if (u != v) graph.adj_list.remove(v, u);
+    if (graph.has_matrix()) {
+        graph.adj_matrix.reset(u, v);
+        graph.adj_matrix.reset(v, u);
+    }
+    // Deleting a self-loop never splits a component
+    if (u != v) graph.connectivity.clear();
+    end_update(graph);
+    return true;
+}
+
+int add_vertex(Graph &graph, const int threads) {
+    begin_update(graph, threads);
+    const int v = graph.adj_list.add_row();
+    graph.n++;
+    graph.ids.append(v);
+    graph.adj_matrix.release();
+    graph.build_ms.matrix = 0;
+    if (!graph.connectivity.empty()) graph.connectivity.add();
+    end_update(graph);
+    return v;
+}
+
+bool connected(Graph &graph, const int u, const int v, const int threads) {
+    check_vertex(graph, u);
+    check_vertex(graph, v);
+    if (graph.connectivity.empty()) {
+        ensure_list(graph, threads);
+        const Components components = connected_components(graph, threads);
+
+        // Component ids follow the smallest member, so the first vertex seen is the root
+        std::vector<int> root(components.count(), -1);
+        graph.connectivity.reset(graph.n);
+        for (int w = 0; w < graph.n; w++) {
+            int& r = root[components.label[w]];
+            if (r < 0) r = w;
+            graph.connectivity.attach(w, r);
+        }
+    }
+    return graph.connectivity.same(u, v);
+}
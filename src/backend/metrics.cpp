@@ -0,0 +1,182 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/metrics.h"
+#include "../../include/backend/graph_convert.h"
+#include "../../include/backend/parallel.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <numeric>
+
+namespace {
+    using word_t = BitMatrix::word_t;
+    constexpr int word_bits = BitMatrix::word_bits;
+
+    // Auto builds the matrix for triangles only up to this size (128 MiB of bits)
+    constexpr int auto_matrix_vertices = 1 << 15;
+    // ... and when rows are at least this dense, a 32-bit list entry then costs more than a row of bits
+    constexpr int auto_density_ratio = 64;
+
+    double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Degree of every vertex without its self-loop
+    template <typename Adjacency>
+    std::vector<int> list_degrees(const Adjacency& adjacency, const int n, const int threads) {
+        std::vector<int> degree(n);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                const auto row = adjacency[static_cast<int>(v)];
+                degree[v] = static_cast<int>(row.size() - std::ranges::count(row, static_cast<int>(v)));
+            }
+        });
+        return degree;
+    }
+
+    std::vector<int> matrix_degrees(const BitMatrix& matrix, const int n, const int threads) {
+        std::vector<int> degree(n);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                const int row = static_cast<int>(v);
+                degree[v] = matrix.row_count(row) - matrix.test(row, row);
+            }
+        });
+        return degree;
+    }
+
+    // Every edge u < v counts the common neighbours above v, so each triangle is seen at its two lowest vertices once
+    long long bitset_triangles(const BitMatrix& matrix, const int n, const int threads) {
+        const std::size_t words = matrix.row_words();
+        std::vector<long long> part(resolve_threads(threads), 0);
+        // Low rows have the most columns above them, keep chunks small to balance
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+            for (std::size_t u = begin; u < end; u++) {
+                const word_t* row_u = matrix.row(static_cast<int>(u));
+                long long count = 0;
+                for (std::size_t w = (u + 1) / word_bits; w < words; w++) {
+                    word_t bits = row_u[w];
+                    if (w == (u + 1) / word_bits) bits &= ~word_t{0} << ((u + 1) % word_bits);
+                    for (; bits != 0; bits &= bits - 1) {
+                        const std::size_t v = w * word_bits + std::countr_zero(bits);
+                        const word_t* row_v = matrix.row(static_cast<int>(v));
+                        const std::size_t first = (v + 1) / word_bits;
+                        if (first >= words) continue;
+                        count += std::popcount(row_u[first] & row_v[first] & (~word_t{0} << ((v + 1) % word_bits)));
+                        for (std::size_t x = first + 1; x < words; x++) count += std::popcount(row_u[x] & row_v[x]);
+                    }
+                }
+                part[id] += count;
+            }
+        }, 16);
+        return std::accumulate(part.begin(), part.end(), 0LL);
+    }
+
+    // Orient every edge towards the higher (degree, id), then count |out(u) & out(v)| per oriented edge u -> v
+    template <typename Adjacency>
+    long long merge_triangles(const Adjacency& adjacency, const std::vector<int>& degree, const int n, const int threads) {
+        const auto before = [&](const int u, const int v) {
+            return degree[u] != degree[v] ? degree[u] < degree[v] : u < v;
+        };
+
+        std::vector<std::size_t> offsets(n + 1, 0);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                const int u = static_cast<int>(v);
+                offsets[v + 1] = std::ranges::count_if(adjacency[u], [&](const int w) { return before(u, w); });
+            }
+        });
+        for (int v = 0; v < n; v++) offsets[v + 1] += offsets[v];
+
+        std::vector<int> out(offsets[n]);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) {
+                const int u = static_cast<int>(v);
+                int* first = out.data() + offsets[v];
+                int* last = std::ranges::copy_if(adjacency[u], first, [&](const int w) { return before(u, w); }).out;
+                std::sort(first, last);
+            }
+        });
+
+        std::vector<long long> part(resolve_threads(threads), 0);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+            long long count = 0;
+            for (std::size_t u = begin; u < end; u++) {
+                const int* a_begin = out.data() + offsets[u];
+                const int* a_end = out.data() + offsets[u + 1];
+                for (const int* it = a_begin; it != a_end; ++it) {
+                    const int* a = a_begin;
+                    const int* b = out.data() + offsets[*it];
+                    const int* b_end = out.data() + offsets[*it + 1];
+                    while (a != a_end && b != b_end) {
+                        if (*a < *b) ++a;
+                        else if (*b < *a) ++b;
+                        else {
+                            count++;
+                            ++a;
+                            ++b;
+                        }
+                    }
+                }
+            }
+            part[id] += count;
+        });
+        return std::accumulate(part.begin(), part.end(), 0LL);
+    }
+}
+
+GraphMetrics graph_metrics(Graph &graph, const int threads, TriangleMethod method) {
+    GraphMetrics metrics;
+    const int n = graph.n;
+    metrics.vertices = n;
+    if (n <= 0) return metrics;
+
+    const GraphStats stats = graph_stats(graph, threads);
+    metrics.edges = stats.edges;
+    metrics.self_loops = stats.self_loops;
+
+    if (method == TriangleMethod::Auto) {
+        const long long entries = 2 * (stats.edges - stats.self_loops);
+        const bool dense = n <= auto_matrix_vertices && entries * auto_density_ratio >= static_cast<long long>(n) * n;
+        method = graph.has_matrix() || dense ? TriangleMethod::Bitset : TriangleMethod::Merge;
+    }
+    metrics.bitset = method == TriangleMethod::Bitset;
+
+    // The representation is built before the clock starts, triangle_ms is the count alone
+    std::vector<int> degree;
+    if (metrics.bitset) {
+        const BitMatrix& matrix = ensure_matrix(graph, threads);
+        degree = matrix_degrees(matrix, n, threads);
+        const auto start = std::chrono::steady_clock::now();
+        metrics.triangles = bitset_triangles(matrix, n, threads);
+        metrics.triangle_ms = elapsed_ms(start);
+    } else {
+        const auto count = [&](const auto& adjacency) {
+            degree = list_degrees(adjacency, n, threads);
+            const auto start = std::chrono::steady_clock::now();
+            metrics.triangles = merge_triangles(adjacency, degree, n, threads);
+            metrics.triangle_ms = elapsed_ms(start);
+        };
+        if (graph.has_csr()) count(graph.csr);
+        else count(ensure_list(graph, threads));
+    }
+
+    long long degree_sum = 0;
+    for (const int d : degree) {
+        degree_sum += d;
+        metrics.wedges += static_cast<long long>(d) * (d - 1) / 2;
+        metrics.max_degree = std::max(metrics.max_degree, d);
+        if (d == 0) {
+            metrics.isolated++;
+            continue;
+        }
+        const auto bucket = static_cast<std::size_t>(std::bit_width(static_cast<unsigned>(d)) - 1);
+        if (metrics.degree_histogram.size() <= bucket) metrics.degree_histogram.resize(bucket + 1, 0);
+        metrics.degree_histogram[bucket]++;
+    }
+    metrics.average_degree = static_cast<double>(degree_sum) / n;
+    return metrics;
+}
@@ -0,0 +1,142 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/perf_counters.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+    SoftCounters read_soft() {
+        SoftCounters counters;
+#ifndef _WIN32
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) == 0) {
+            counters.minor_faults = usage.ru_minflt;
+            counters.major_faults = usage.ru_majflt;
+            counters.context_switches = usage.ru_nvcsw + usage.ru_nivcsw;
+        }
+#endif
+        return counters;
+    }
+
+#ifdef __linux__
+    constexpr std::uint64_t cache_event(const std::uint64_t cache, const std::uint64_t op, const std::uint64_t result) {
+        return cache | op << 8 | result << 16;
+    }
+
+    // type/config pair of every HwEvent, in enum order
+    constexpr std::pair<std::uint32_t, std::uint64_t> event_codes[] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {PERF_TYPE_HW_CACHE, cache_event(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    };
+
+    int open_event(const std::uint32_t type, const std::uint64_t config) {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1;          // Threads started by parallel_for count too
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+}
+
+PerfCounters::PerfCounters() {
+    fds.fill(-1);
+#ifdef __linux__
+    for (std::size_t i = 0; i < event_count; i++) {
+        fds[i] = open_event(event_codes[i].first, event_codes[i].second);
+        if (fds[i] < 0 && reason.empty()) reason = std::string("perf_event_open: ") + std::strerror(errno);
+    }
+#else
+    reason = "hardware counters need Linux perf_event_open";
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (const int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+#endif
+}
+
+bool PerfCounters::any_available() const {
+    return std::ranges::any_of(fds, [](const int fd) { return fd >= 0; });
+}
+
+void PerfCounters::start() {
+    values.fill(0);
+    scaled.fill(false);
+    soft_start = read_soft();
+#ifdef __linux__
+    for (const int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+void PerfCounters::stop() {
+#ifdef __linux__
+    for (const int fd : fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (std::size_t i = 0; i < event_count; i++) {
+        if (fds[i] < 0) continue;
+        std::uint64_t data[3] = {};  // value, time enabled, time running
+        if (read(fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        values[i] = data[0];
+        if (data[2] > 0 && data[2] < data[1]) {
+            values[i] = static_cast<std::uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1])
+                                                   / static_cast<double>(data[2]));
+            scaled[i] = true;
+        }
+    }
+#endif
+    const SoftCounters now = read_soft();
+    soft_delta.minor_faults = now.minor_faults - soft_start.minor_faults;
+    soft_delta.major_faults = now.major_faults - soft_start.major_faults;
+    soft_delta.context_switches = now.context_switches - soft_start.context_switches;
+}
+
+std::optional<std::uint64_t> PerfCounters::value(const HwEvent event) const {
+    if (!available(event)) return std::nullopt;
+    return values[index(event)];
+}
+
+const char* PerfCounters::name(const HwEvent event) {
+    switch (event) {
+        case HwEvent::Cycles: return "cycles";
+        case HwEvent::Instructions: return "instructions";
+        case HwEvent::L1dMisses: return "L1d misses";
+        case HwEvent::LlcMisses: return "LLC misses";
+        case HwEvent::BranchMisses: return "branch misses";
+        case HwEvent::DtlbMisses: return "dTLB misses";
+        default: return "?";
+    }
+}
@@ -0,0 +1,212 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/reorder.h"
+#include "../../include/backend/graph_convert.h"
+#include "../../include/backend/parallel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // Chunks below this size are not worth a thread of their own
+    constexpr std::size_t min_sort_run = 1 << 14;
+
+    double elapsed_ms(const std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Every thread sorts one chunk, then sorted runs are merged pairwise level by level
+    template <typename Less>
+    void parallel_sort(std::vector<int>& values, const Less& less, const int threads) {
+        const std::size_t count = values.size();
+        const std::size_t runs = std::clamp<std::size_t>(count / min_sort_run, 1, resolve_threads(threads));
+        std::size_t width = (count + runs - 1) / runs;
+        parallel_for(runs, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t r = begin; r < end; r++) {
+                std::sort(values.begin() + std::min(count, r * width), values.begin() + std::min(count, (r + 1) * width), less);
+            }
+        }, 1);
+
+        std::vector<int> merged(count);
+        for (; width < count; width *= 2) {
+            const std::size_t pairs = (count + 2 * width - 1) / (2 * width);
+            parallel_for(pairs, threads, [&](const std::size_t begin, const std::size_t end, int) {
+                for (std::size_t p = begin; p < end; p++) {
+                    const std::size_t low = p * 2 * width;
+                    const std::size_t mid = std::min(count, low + width);
+                    const std::size_t high = std::min(count, low + 2 * width);
+                    std::merge(values.begin() + low, values.begin() + mid, values.begin() + mid, values.begin() + high,
+                               merged.begin() + low, less);
+                }
+            }, 1);
+            values.swap(merged);
+        }
+    }
+
+    /**
+     * Breadth-first sweep over every component, a new one starts at the next unplaced
+     * vertex of starts. With degree, the children of each vertex are queued by ascending
+     * degree (Cuthill-McKee), otherwise in row order.
+     */
+    template <typename Adjacency>
+    void sweep(const Adjacency& adjacency, const std::vector<int>& starts, const std::vector<int>* degree,
+               std::vector<int>& order) {
+        std::vector<char> placed(starts.size(), 0);
+        order.clear();
+        order.reserve(starts.size());
+        const auto by_degree = [&](const int a, const int b) {
+            return (*degree)[a] != (*degree)[b] ? (*degree)[a] < (*degree)[b] : a < b;
+        };
+
+        for (const int start : starts) {
+            if (placed[start]) continue;
+            placed[start] = 1;
+            order.push_back(start);
+            for (std::size_t head = order.size() - 1; head < order.size(); head++) {
+                const std::size_t first = order.size();
+                for (const int w : adjacency[order[head]]) {
+                    if (!placed[w]) {
+                        placed[w] = 1;
+                        order.push_back(w);
+                    }
+                }
+                if (degree != nullptr) std::sort(order.begin() + first, order.end(), by_degree);
+            }
+        }
+    }
+
+    // Mean and largest gap over all entries, rank maps row ids to labels (identity when empty)
+    template <typename Adjacency>
+    void measure_gaps(const Adjacency& adjacency, const int n, const std::vector<int>& rank, const int threads,
+                      double& mean, long long& bandwidth) {
+        const int workers = resolve_threads(threads);
+        std::vector<long long> part_sum(workers, 0), part_entries(workers, 0), part_max(workers, 0);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, const int id) {
+            for (std::size_t v = begin; v < end; v++) {
+                const long long label = rank.empty() ? static_cast<long long>(v) : rank[v];
+                for (const int w : adjacency[static_cast<int>(v)]) {
+                    const long long gap = std::llabs(label - (rank.empty() ? w : rank[w]));
+                    part_sum[id] += gap;
+                    part_max[id] = std::max(part_max[id], gap);
+                }
+                part_entries[id] += static_cast<long long>(adjacency[static_cast<int>(v)].size());
+            }
+        });
+        const long long entries = std::accumulate(part_entries.begin(), part_entries.end(), 0LL);
+        mean = entries == 0 ? 0.0 : static_cast<double>(std::accumulate(part_sum.begin(), part_sum.end(), 0LL))
+                                    / static_cast<double>(entries);
+        bandwidth = *std::max_element(part_max.begin(), part_max.end());
+    }
+
+    // order[i] = vertex that gets new id i
+    template <typename Adjacency>
+    std::vector<int> compute_order(const Adjacency& adjacency, const int n, const VertexOrder kind, const int threads) {
+        std::vector<int> degree(n);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t v = begin; v < end; v++) degree[v] = static_cast<int>(adjacency[static_cast<int>(v)].size());
+        });
+
+        std::vector<int> vertices(n);
+        std::iota(vertices.begin(), vertices.end(), 0);
+        if (kind == VertexOrder::Degree) {
+            parallel_sort(vertices, [&](const int a, const int b) {
+                return degree[a] != degree[b] ? degree[a] > degree[b] : a < b;
+            }, threads);
+            return vertices;
+        }
+
+        std::vector<int> order;
+        if (kind == VertexOrder::Bfs) {
+            sweep(adjacency, vertices, nullptr, order);
+            return order;
+        }
+        // Every component starts from its lowest-degree vertex, a cheap stand-in for a peripheral one
+        parallel_sort(vertices, [&](const int a, const int b) {
+            return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+        }, threads);
+        sweep(adjacency, vertices, &degree, order);
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+    template <typename Adjacency>
+    ReorderStats relabel(Graph& graph, const Adjacency& adjacency, const VertexOrder kind, const int threads,
+                         const bool had_list, const bool had_matrix) {
+        const int n = graph.n;
+        ReorderStats stats;
+        measure_gaps(adjacency, n, {}, threads, stats.gap_before, stats.bandwidth_before);
+
+        auto start = std::chrono::steady_clock::now();
+        const std::vector<int> order = compute_order(adjacency, n, kind, threads);
+        std::vector<int> rank(n);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t i = begin; i < end; i++) rank[order[i]] = static_cast<int>(i);
+        });
+        stats.order_ms = elapsed_ms(start);
+        measure_gaps(adjacency, n, rank, threads, stats.gap_after, stats.bandwidth_after);
+
+        start = std::chrono::steady_clock::now();
+        Graph fresh(n, graph.arena->options());
+        CSR csr;
+        csr.offsets = fresh.allocate<CSR::offset_type>(n + 1);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t i = begin; i < end; i++) {
+                csr.offsets[i + 1] = static_cast<CSR::offset_type>(adjacency[order[i]].size());
+            }
+        });
+        std::size_t total = 0;
+        for (int i = 0; i < n; i++) {
+            total += csr.offsets[i + 1];
+            if (total > std::numeric_limits<CSR::offset_type>::max()) {
+                throw std::length_error("Graph too large for CSR offsets, rebuild with CSR_64BIT_OFFSETS");
+            }
+            csr.offsets[i + 1] = static_cast<CSR::offset_type>(total);
+        }
+        csr.neighbours = fresh.allocate<int>(total);
+
+        // Rows are written by their owner thread and sorted in place, so scans walk ids upwards
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t i = begin; i < end; i++) {
+                int* out = csr.neighbours.data() + csr.offsets[i];
+                const auto row = adjacency[order[i]];
+                std::ranges::transform(row, out, [&](const int w) { return rank[w]; });
+                std::sort(out, out + row.size());
+            }
+        });
+        fresh.csr = std::move(csr);
+        fresh.build_ms.generate = graph.build_ms.generate;
+        fresh.build_ms.csr = elapsed_ms(start);
+        if (had_list) ensure_list(fresh, threads);
+        if (had_matrix) ensure_matrix(fresh, threads);
+
+        fresh.ids.original.resize(n);
+        fresh.ids.current.resize(n);
+        parallel_for(n, threads, [&](const std::size_t begin, const std::size_t end, int) {
+            for (std::size_t i = begin; i < end; i++) {
+                const int original = graph.ids.to_original(order[i]);
+                fresh.ids.original[i] = original;
+                fresh.ids.current[original] = static_cast<int>(i);
+            }
+        });
+        stats.relabel_ms = elapsed_ms(start);
+
+        // Connectivity is rebuilt under the new ids by the next connected() query
+        graph = std::move(fresh);
+        return stats;
+    }
+}
+
+ReorderStats reorder_graph(Graph &graph, const VertexOrder order, const int threads) {
+    if (graph.n <= 0) return {};
+    const bool had_list = graph.has_list();
+    const bool had_matrix = graph.has_matrix();
+    if (graph.has_csr()) return relabel(graph, graph.csr, order, threads, had_list, had_matrix);
+    return relabel(graph, ensure_list(graph, threads), order, threads, had_list, had_matrix);
+}
@@ -0,0 +1,242 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include "../../include/backend/snapshot.h"
+
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    constexpr char magic[8] = {'L', 'A', 'B', '7', 'G', 'R', 'P', 'H'};
+
+    std::uint64_t align_up(const std::uint64_t value) {
+        return (value + snapshot_section_alignment - 1) / snapshot_section_alignment * snapshot_section_alignment;
+    }
+
+    void write_section(std::ofstream& file, std::uint64_t& pos, const std::uint64_t target, const void* data,
+                       const std::uint64_t bytes) {
+        static constexpr char zeros[snapshot_section_alignment] = {};
+        file.write(zeros, static_cast<std::streamsize>(target - pos));
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        pos = target + bytes;
+    }
+
+    // Whole file as one readable and privately writable block, released with the returned owner
+    std::shared_ptr<void> map_file(const std::string& path, std::uint64_t& size) {
+#ifdef _WIN32
+        // No mmap here, read the file into an equally aligned heap block instead
+        std::ifstream file(path, std::ios::binary);
+        if (!file) throw std::runtime_error("cannot open " + path);
+        size = std::filesystem::file_size(path);
+        void* block = ::operator new(size, std::align_val_t{snapshot_section_alignment});
+        std::shared_ptr<void> owner(block, [](void* p) {
+            ::operator delete(p, std::align_val_t{snapshot_section_alignment});
+        });
+        if (!file.read(static_cast<char*>(block), static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("cannot read " + path);
+        }
+        return owner;
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("cannot open " + path + ": " + std::strerror(errno));
+
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+            ::close(fd);
+            throw std::runtime_error(path + " is not a graph snapshot");
+        }
+        size = static_cast<std::uint64_t>(info.st_size);
+
+        // Private mapping: pages stay shared with the page cache until something writes to them
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (base == MAP_FAILED) throw std::runtime_error("cannot map " + path + ": " + std::strerror(errno));
+        return {base, [size](void* p) { ::munmap(p, size); }};
+#endif
+    }
+
+    // count and item_bytes come from the header, so compare by division: count * item_bytes may wrap
+    void check_section(const std::uint64_t pos, const std::uint64_t count, const std::uint64_t item_bytes,
+                       const std::uint64_t size) {
+        if (pos % SharedArray<int>::alignment != 0 || pos > size || count > (size - pos) / item_bytes) {
+            throw std::runtime_error("snapshot section out of bounds");
+        }
+    }
+
+    template <typename Stored>
+    SharedArray<CSR::offset_type> adopt_offsets(Graph& graph, char* base, const SnapshotHeader& header,
+                                                const std::shared_ptr<void>& owner) {
+        const std::size_t count = header.vertices + 1;
+        auto* stored = reinterpret_cast<Stored*>(base + header.offsets_pos);
+        if constexpr (std::is_same_v<Stored, CSR::offset_type>) {
+            return {stored, count, owner};
+        } else {
+            // Snapshot written with the other offset width, convert once
+            if (header.entries > std::numeric_limits<CSR::offset_type>::max()) {
+                throw std::runtime_error("snapshot too large for CSR offsets, rebuild with CSR_64BIT_OFFSETS");
+            }
+            SharedArray<CSR::offset_type> offsets = graph.allocate<CSR::offset_type>(count);
+            for (std::size_t v = 0; v < count; v++) offsets[v] = static_cast<CSR::offset_type>(stored[v]);
+            return offsets;
+        }
+    }
+
+    // Reject rows that run backwards or neighbour ids outside [0, n) before anything indexes with them
+    void check_csr(const CSR& csr, const int n) {
+        for (int v = 0; v < n; v++) {
+            if (csr.offsets[v + 1] < csr.offsets[v]) throw std::runtime_error("snapshot CSR offsets decrease");
+        }
+        for (const int w : csr.neighbours) {
+            if (w < 0 || w >= n) throw std::runtime_error("snapshot neighbour id " + std::to_string(w) + " out of range");
+        }
+    }
+
+    // Copy the stored original ids and rebuild the inverse, which also proves they are a permutation
+    void load_ids(VertexIds& ids, const int* stored, const int n) {
+        ids.original.assign(stored, stored + n);
+        ids.current.assign(n, -1);
+        for (int v = 0; v < n; v++) {
+            const int o = ids.original[v];
+            if (o < 0 || o >= n || ids.current[o] >= 0) throw std::runtime_error("snapshot id map is not a permutation");
+            ids.current[o] = v;
+        }
+    }
+}
+
+std::uint64_t save_snapshot(const Graph &graph, const std::string &path) {
+    if (graph.n > 0 && !graph.has_csr()) throw std::invalid_argument("snapshot needs the CSR representation");
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = snapshot_version;
+    header.byte_order = snapshot_byte_order;
+    header.offset_bytes = sizeof(CSR::offset_type);
+    header.vertices = static_cast<std::uint64_t>(graph.n);
+    header.entries = graph.csr.entries();
+
+    const std::uint64_t offsets_bytes = graph.csr.offsets.bytes();
+    const std::uint64_t neighbours_bytes = graph.csr.neighbours.bytes();
+    const std::uint64_t matrix_bytes = graph.adj_matrix.bytes();
+
+    header.offsets_pos = align_up(sizeof(SnapshotHeader));
+    header.neighbours_pos = align_up(header.offsets_pos + offsets_bytes);
+    header.file_bytes = header.neighbours_pos + neighbours_bytes;
+    if (!graph.adj_matrix.empty()) {
+        header.flags |= snapshot_has_matrix;
+        header.matrix_pos = align_up(header.file_bytes);
+        header.matrix_stride = graph.adj_matrix.stride();
+        header.file_bytes = header.matrix_pos + matrix_bytes;
+    }
+    const std::uint64_t ids_bytes = graph.ids.original.size() * sizeof(int);
+    if (!graph.ids.identity()) {
+        header.flags |= snapshot_has_ids;
+        header.ids_pos = align_up(header.file_bytes);
+        header.file_bytes = header.ids_pos + ids_bytes;
+    }
+
+    // The graph may be mapped from path itself (load_snapshot), so never truncate it in place:
+    // write a temporary file next to it and rename it over the target once complete
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file) throw std::runtime_error("cannot open " + temporary + " for writing");
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        std::uint64_t pos = sizeof(header);
+        write_section(file, pos, header.offsets_pos, graph.csr.offsets.data(), offsets_bytes);
+        write_section(file, pos, header.neighbours_pos, graph.csr.neighbours.data(), neighbours_bytes);
+        if (!graph.adj_matrix.empty()) {
+            write_section(file, pos, header.matrix_pos, graph.adj_matrix.row(0), matrix_bytes);
+        }
+        if (!graph.ids.identity()) {
+            write_section(file, pos, header.ids_pos, graph.ids.original.data(), ids_bytes);
+        }
+
+        file.flush();
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temporary);
+            throw std::runtime_error("write to " + temporary + " failed");
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::filesystem::remove(temporary);
+        throw std::runtime_error("cannot replace " + path + ": " + error.message());
+    }
+    return header.file_bytes;
+}
+
+Graph load_snapshot(const std::string &path) {
+    const auto start = std::chrono::steady_clock::now();
+    std::uint64_t size = 0;
+    const std::shared_ptr<void> owner = map_file(path, size);
+    auto* base = static_cast<char*>(owner.get());
+
+    SnapshotHeader header{};
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) {
+        throw std::runtime_error(path + " is not a graph snapshot");
+    }
+    if (header.version != snapshot_version) {
+        throw std::runtime_error("unsupported snapshot version " + std::to_string(header.version));
+    }
+    if (header.byte_order != snapshot_byte_order) {
+        throw std::runtime_error("snapshot was written on a host with a different byte order");
+    }
+    if (header.file_bytes != size) throw std::runtime_error("snapshot is truncated");
+    if (header.vertices > static_cast<std::uint64_t>(INT_MAX)) throw std::runtime_error("snapshot has too many vertices");
+    if (header.offset_bytes != 4 && header.offset_bytes != 8) throw std::runtime_error("bad snapshot offset width");
+    if ((header.flags & ~(snapshot_has_matrix | snapshot_has_ids)) != 0) throw std::runtime_error("unknown snapshot flags");
+
+    const auto n = static_cast<int>(header.vertices);
+    check_section(header.offsets_pos, header.vertices + 1, header.offset_bytes, size);
+    check_section(header.neighbours_pos, header.entries, sizeof(int), size);
+
+    // The mapping owns the data, the graph's arena only serves later conversions
+    Graph graph(n);
+    graph.csr.offsets = header.offset_bytes == 4
+        ? adopt_offsets<std::uint32_t>(graph, base, header, owner)
+        : adopt_offsets<std::uint64_t>(graph, base, header, owner);
+    graph.csr.neighbours = SharedArray<int>(reinterpret_cast<int*>(base + header.neighbours_pos),
+                                            header.entries, owner);
+    if (graph.csr.offsets[0] != 0 || graph.csr.offsets[n] != header.entries) {
+        throw std::runtime_error("snapshot CSR offsets are inconsistent");
+    }
+    check_csr(graph.csr, n);
+
+    if ((header.flags & snapshot_has_matrix) != 0) {
+        if (header.matrix_stride != BitMatrix::padded_stride(n)) throw std::runtime_error("bad snapshot matrix layout");
+        // Both factors are bounded by now (vertices <= INT_MAX, stride checked above)
+        const std::uint64_t words = header.vertices * header.matrix_stride;
+        check_section(header.matrix_pos, words, sizeof(BitMatrix::word_t), size);
+        graph.adj_matrix = BitMatrix(n, n, SharedArray<BitMatrix::word_t>(
+            reinterpret_cast<BitMatrix::word_t*>(base + header.matrix_pos), words, owner));
+    }
+
+    if ((header.flags & snapshot_has_ids) != 0) {
+        check_section(header.ids_pos, header.vertices, sizeof(int), size);
+        load_ids(graph.ids, reinterpret_cast<const int*>(base + header.ids_pos), n);
+    }
+
+    graph.build_ms.generate = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return graph;
+}
@@ -1,9 +1,54 @@
 #include "../include/adapters/console_adapter.h"
 
-int main() {
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    // operator new calls since start, reported per command by the console's perf/time
+    std::atomic<std::uint64_t> allocation_count{0};
+
+    void print_usage(const char* program) {
+        std::cerr << "Usage: " << program << " [--script <file> | -c \"cmd; cmd; ...\"]" << std::endl;
+    }
+}
+
+// Counting replacements of the global allocation functions; the array and nothrow
+// forms forward here by default, over-aligned allocations are not counted
+void* operator new(const std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+int main(int argc, char* argv[]) {
     try {
+        const std::vector<std::string> args(argv + 1, argv + argc);
+        if (args.empty()) {
+            GraphConsoleAdapter console;
+            console.count_allocations(allocation_count);
+            console.run();
+            return 0;
+        }
+
+        // Batch mode: no prompt or colors, exit status reports the first failing command
+        if (args.size() != 2 || (args[0] != "--script" && args[0] != "-c")) {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        const std::vector<std::string> commands = args[0] == "--script" ? Console::read_script(args[1])
+                                                                        : Console::split_commands(args[1]);
         GraphConsoleAdapter console;
-        console.run();
+        console.count_allocations(allocation_count);
+        return console.run_batch(commands);
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         return EXIT_FAILURE;
@@ -11,5 +56,4 @@ int main() {
         std::cerr << "Unknown exception" << std::endl;
         return EXIT_FAILURE;
     }
-    return 0;
 }
\ No newline at end of file
@@ -0,0 +1,152 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "adapters/console_adapter.h"
+#include "core/console.h"
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    // Paths that do not exist, so the tests run on the built-in defaults, not the user's config
+    constexpr const char* no_config = "no_such_graph_console.conf";
+    constexpr const char* no_aliases = "no_such_aliases.conf";
+
+    struct BatchResult {
+        int status;
+        std::string out;
+        std::string err;
+    };
+
+    // Redirects std::cout and std::cerr for its lifetime
+    class CaptureOutput {
+    public:
+        CaptureOutput() : cout_buffer(std::cout.rdbuf(out.rdbuf())), cerr_buffer(std::cerr.rdbuf(err.rdbuf())) {}
+
+        ~CaptureOutput() {
+            std::cout.rdbuf(cout_buffer);
+            std::cerr.rdbuf(cerr_buffer);
+        }
+
+        CaptureOutput(const CaptureOutput&) = delete;
+        CaptureOutput& operator=(const CaptureOutput&) = delete;
+
+        std::ostringstream out;
+        std::ostringstream err;
+
+    private:
+        std::streambuf* cout_buffer;
+        std::streambuf* cerr_buffer;
+    };
+
+    // Batch run on a fresh adapter, destroyed before the output is returned
+    BatchResult run_batch(const std::vector<std::string>& commands) {
+        const CaptureOutput capture;
+        int status;
+        {
+            GraphConsoleAdapter adapter(no_config, no_aliases);
+            status = adapter.run_batch(commands);
+        }
+        return {status, capture.out.str(), capture.err.str()};
+    }
+
+    bool contains(const std::string& text, const std::string& part) {
+        return text.find(part) != std::string::npos;
+    }
+}
+
+TEST(Batch, SplitsCommandsAndSkipsComments) {
+    const auto commands = Console::split_commands("create 10 0.5 0.1; stats\n# a comment\n\n  BFS 0 --l ;\n");
+    EXPECT_EQ(commands, (std::vector<std::string>{"create 10 0.5 0.1", "stats", "BFS 0 --l"}));
+}
+
+TEST(Batch, RunsEveryCommandWithoutPrompt) {
+    const auto [status, out, err] = run_batch({"create 50 0.2 0.1 --seed 1", "BFS 0 --l", "stats"});
+    EXPECT_EQ(status, 0);
+    EXPECT_TRUE(contains(out, "Created two graphs with 50 vertices as 'main'"));
+    EXPECT_TRUE(contains(out, "List BFS from 0"));
+    EXPECT_TRUE(contains(out, "Vertices: 50"));
+    EXPECT_FALSE(contains(out, "> "));
+    EXPECT_TRUE(err.empty());
+}
+
+TEST(Batch, StopsAtFirstFailingCommand) {
+    const auto [status, out, err] = run_batch({"create 50 0.2 0.1 --seed 1", "no-such-command", "stats"});
+    EXPECT_EQ(status, 1);
+    EXPECT_TRUE(contains(err, "Command 2 failed: no-such-command"));
+    EXPECT_FALSE(contains(out, "Vertices:"));
+}
+
+TEST(Batch, ExitEndsWithSuccess) {
+    const auto [status, out, err] = run_batch({"create 50 0.2 0.1 --seed 1", "exit", "stats"});
+    EXPECT_EQ(status, 0);
+    EXPECT_FALSE(contains(out, "Vertices:"));
+}
+
+TEST(Jobs, WaitReportsJobOutput) {
+    const auto [status, out, err] = run_batch({"create 200 0.1 0.1 --seed 1 &", "wait 1", "stats"});
+    EXPECT_EQ(status, 0);
+    EXPECT_TRUE(contains(out, "[1] create 200 0.1 0.1 --seed 1"));
+    EXPECT_TRUE(contains(out, "[1] done"));
+    EXPECT_TRUE(contains(out, "Created two graphs with 200 vertices"));
+    EXPECT_TRUE(contains(out, "Vertices: 200"));
+}
+
+TEST(Jobs, FailedJobFailsTheBatch) {
+    const auto [status, out, err] = run_batch({"BFS 0 &", "wait"});
+    EXPECT_EQ(status, 1);
+    EXPECT_TRUE(contains(out, "[1] failed"));
+    EXPECT_TRUE(contains(out, "No graphs created"));
+}
+
+TEST(Jobs, UnfinishedJobsAreWaitedForAtTheEnd) {
+    const auto [status, out, err] = run_batch({"create 200 0.1 0.1 --seed 1 &"});
+    EXPECT_EQ(status, 0);
+    EXPECT_TRUE(contains(out, "[1] done"));
+}
+
+TEST(Jobs, CancelledJobLeavesNoGraph) {
+    const auto [status, out, err] = run_batch({
+        "create 20000 0.1 0.1 --mode rmat --seed 1 --name a &",
+        "create 20000 0.1 0.1 --mode rmat --seed 1 --name b &",
+        "cancel 2",
+        "wait",
+        "use a"
+    });
+    EXPECT_EQ(status, 0);
+    EXPECT_TRUE(contains(out, "[2] cancelling"));
+    EXPECT_TRUE(contains(out, "[2] cancelled"));
+    EXPECT_FALSE(contains(out, "as 'b'"));
+}
+
+TEST(Jobs, WaitIsRefusedInsideJobs) {
+    // The worker would wait for its own job
+    auto result = run_batch({"create 10 0.5 0.1", "time wait &"});
+    EXPECT_EQ(result.status, 1);
+    EXPECT_TRUE(contains(result.err, "Command 2 failed: time wait &"));
+
+    result = run_batch({"create 10 0.5 0.1", "profile wait &", "wait"});
+    EXPECT_EQ(result.status, 1);
+    EXPECT_TRUE(contains(result.out, "wait is not available in a background job"));
+}
+
+TEST(Jobs, OtherGraphsStayUsable) {
+    const auto [status, out, err] = run_batch({
+        "create 100 0.1 0.1 --seed 1 --name small",
+        "create 100000 0.1 0.1 --mode rmat --seed 1 --name big &",
+        "use small",
+        "stats",
+        "graphs",
+        "wait",
+        "use big"
+    });
+    EXPECT_EQ(status, 0);
+    EXPECT_TRUE(contains(out, "Vertices: 100,"));
+    EXPECT_TRUE(contains(out, "Created two graphs with 100000 vertices as 'big'"));
+    EXPECT_FALSE(contains(out, "Busy"));
+}
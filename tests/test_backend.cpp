@@ -0,0 +1,476 @@
+//
+// Created by IWOFLEUR on 17.10.2026.
+//
+
+#include <gtest/gtest.h>
+
+#include "backend/bfs.h"
+#include "backend/components.h"
+#include "backend/edge_import.h"
+#include "backend/graph_convert.h"
+#include "backend/graph_gen.h"
+#include "backend/graph_update.h"
+#include "backend/metrics.h"
+#include "backend/reorder.h"
+#include "backend/snapshot.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    constexpr std::uint64_t seed = 0x5eed;
+
+    void expect_same_csr(const CSR& expected, const CSR& actual) {
+        ASSERT_EQ(expected.offsets.size(), actual.offsets.size());
+        ASSERT_EQ(expected.neighbours.size(), actual.neighbours.size());
+        EXPECT_TRUE(std::equal(expected.offsets.begin(), expected.offsets.end(), actual.offsets.begin()));
+        EXPECT_TRUE(std::equal(expected.neighbours.begin(), expected.neighbours.end(), actual.neighbours.begin()));
+    }
+
+    // Rows of whichever representation is built, for comparing graphs built different ways
+    std::vector<std::vector<int>> rows(Graph& graph) {
+        const AdjacencyList& list = ensure_list(graph, 1);
+        std::vector<std::vector<int>> out(graph.n);
+        for (int v = 0; v < graph.n; v++) {
+            out[v].assign(list[v].begin(), list[v].end());
+            std::ranges::sort(out[v]);
+        }
+        return out;
+    }
+
+    // Serial BFS distances over sorted rows
+    std::vector<int> reference_distances(const std::vector<std::vector<int>>& adjacency, const int source) {
+        std::vector<int> distance(adjacency.size(), -1);
+        std::vector<int> queue = {source};
+        distance[source] = 0;
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            for (const int w : adjacency[queue[head]]) {
+                if (distance[w] >= 0) continue;
+                distance[w] = distance[queue[head]] + 1;
+                queue.push_back(w);
+            }
+        }
+        return distance;
+    }
+
+    // Serial component labels, numbered by smallest member like connected_components
+    std::vector<int> reference_labels(const std::vector<std::vector<int>>& adjacency) {
+        const int n = static_cast<int>(adjacency.size());
+        std::vector<int> label(n, -1);
+        int next = 0;
+        for (int v = 0; v < n; v++) {
+            if (label[v] >= 0) continue;
+            const std::vector<int> distance = reference_distances(adjacency, v);
+            for (int w = 0; w < n; w++) {
+                if (distance[w] >= 0) label[w] = next;
+            }
+            next++;
+        }
+        return label;
+    }
+
+    std::filesystem::path temp_file(const std::string& name) {
+        return std::filesystem::temp_directory_path() / ("lab7_test_" + name);
+    }
+
+    SnapshotHeader read_header(const std::filesystem::path& path) {
+        SnapshotHeader header{};
+        std::ifstream file(path, std::ios::binary);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        return header;
+    }
+
+    template <typename T>
+    void patch(const std::filesystem::path& path, const std::uint64_t pos, const T value) {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(pos));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+}
+
+TEST(ParallelGenerator, BitIdenticalForAnyThreadCount) {
+    for (const bool sparse : {false, true}) {
+        const Graph expected = create_graph_parallel(3000, 0.01, 0.1, seed, 1, sparse);
+        for (const int threads : {2, 3, 8}) {
+            const Graph actual = create_graph_parallel(3000, 0.01, 0.1, seed, threads, sparse);
+            SCOPED_TRACE("sparse " + std::to_string(sparse) + ", threads " + std::to_string(threads));
+            expect_same_csr(expected.csr, actual.csr);
+        }
+    }
+}
+
+TEST(SparseGenerator, SymmetricRowsWithExpectedEdgeCount) {
+    constexpr int n = 4000;
+    constexpr double edge_prob = 0.002, loop_prob = 0.1;
+    const Graph graph = create_graph_sparse(n, edge_prob, loop_prob, seed);
+    expect_same_csr(graph.csr, create_graph_sparse(n, edge_prob, loop_prob, seed).csr);
+
+    long long edges = 0, loops = 0;
+    for (int v = 0; v < n; v++) {
+        const auto row = graph.csr[v];
+        ASSERT_TRUE(std::ranges::is_sorted(row));
+        EXPECT_EQ(std::ranges::adjacent_find(row), row.end()) << "duplicate in row " << v;
+        for (const int w : row) {
+            ASSERT_TRUE(w >= 0 && w < n);
+            const auto back = graph.csr[w];
+            EXPECT_TRUE(std::ranges::binary_search(back, v)) << v << " - " << w << " is one-way";
+            if (w == v) loops++;
+            else if (w < v) edges++;
+        }
+    }
+
+    // Both counts are binomial, allow six standard deviations
+    const double pairs = static_cast<double>(n) * (n - 1) / 2;
+    EXPECT_NEAR(static_cast<double>(edges), pairs * edge_prob, 6 * std::sqrt(pairs * edge_prob));
+    EXPECT_NEAR(static_cast<double>(loops), n * loop_prob, 6 * std::sqrt(n * loop_prob));
+}
+
+TEST(Components, MatchSerialReference) {
+    Graph graph = create_graph_parallel(5000, 0.0003, 0.01, seed, 1, true);
+    const std::vector<std::vector<int>> adjacency = rows(graph);
+    const std::vector<int> expected = reference_labels(adjacency);
+
+    for (const int threads : {1, 4}) {
+        const Components components = connected_components(graph, threads);
+        EXPECT_EQ(expected, components.label);
+        std::vector<int> size(components.count(), 0);
+        for (const int label : expected) size[label]++;
+        EXPECT_EQ(size, components.size);
+    }
+}
+
+TEST(Bfs, MatchesSerialReference) {
+    Graph graph = create_graph_parallel(2000, 0.003, 0.05, seed, 1, true);
+    const std::vector<std::vector<int>> adjacency = rows(graph);
+    ensure_matrix(graph, 1);
+
+    for (const int source : {0, 999}) {
+        const std::vector<int> expected = reference_distances(adjacency, source);
+        for (const int threads : {1, 4}) {
+            BFSResult matrix, list;
+            BFS(source, graph, matrix, threads);
+            BFS_list(source, graph, list, threads);
+            EXPECT_EQ(expected, matrix.distance);
+            EXPECT_EQ(expected, list.distance);
+
+            // Any valid BFS tree: every parent is a neighbour one level up
+            for (int v = 0; v < graph.n; v++) {
+                const int parent = list.parent[v];
+                if (v == source || expected[v] < 0) {
+                    EXPECT_EQ(parent, -1);
+                    continue;
+                }
+                ASSERT_GE(parent, 0);
+                EXPECT_EQ(expected[parent], expected[v] - 1);
+                EXPECT_TRUE(std::ranges::binary_search(adjacency[v], parent));
+            }
+        }
+    }
+}
+
+TEST(EdgeImport, DeduplicatesAndSortsRows) {
+    const auto path = temp_file("edges.txt");
+    std::ofstream(path) << "# comment\n3 1 trailing text\n0 1\n1 0\n2 2\n2 2\n\n% other comment\n5 0\n";
+
+    ImportStats stats;
+    Graph graph = import_edge_list(path.string(), stats, 2);
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(graph.n, 6);
+    EXPECT_EQ(stats.edges, 6u);
+    EXPECT_EQ(stats.duplicates, 2u);
+    EXPECT_EQ(stats.loops, 1u);
+    const std::vector<std::vector<int>> expected = {{1, 5}, {0, 3}, {2}, {1}, {}, {0}};
+    for (int v = 0; v < graph.n; v++) {
+        const auto row = graph.csr[v];
+        EXPECT_EQ(expected[v], std::vector<int>(row.begin(), row.end())) << "row " << v;
+    }
+}
+
+TEST(EdgeImport, RejectsMalformedLines) {
+    const auto path = temp_file("malformed.txt");
+    std::ofstream(path) << "0 1\n2 x\n";
+    ImportStats stats;
+    EXPECT_THROW(import_edge_list(path.string(), stats, 1), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(Dfs, IterativeMatchesRecursive) {
+    Graph graph = create_graph(400, 0.02, 0.1, 7);
+    ensure_list(graph, 1);
+    ensure_csr(graph, 1);
+    const auto search = [&](const auto& dfs, const int v, const bool recursive) {
+        TraversalWorkspace workspace;
+        Traversal out;
+        out.reset(graph.n);
+        workspace.visited.prepare(graph.n);
+        dfs(v, graph, workspace, recursive, out);
+        return out;
+    };
+
+    for (const auto dfs : {&DFS, &DFS_list, &DFS_csr}) {
+        for (const int v : {0, 17, 399}) {
+            const Traversal recursive = search(dfs, v, true);
+            const Traversal iterative = search(dfs, v, false);
+            ASSERT_EQ(recursive.order, iterative.order);
+            for (const int w : recursive.order) EXPECT_EQ(recursive.parent[w], iterative.parent[w]);
+        }
+    }
+}
+
+TEST(Dfs, ReorderKeepsReachedVertices) {
+    for (const VertexOrder order : {VertexOrder::Rcm, VertexOrder::Bfs, VertexOrder::Degree}) {
+        Graph graph = create_graph_sparse(40, 0.03, 0.01, 11);
+        Traversal before, after;
+        TraversalWorkspace workspace;
+        prep_csr(graph, 3, true, before, workspace);
+        reorder_graph(graph, order, 1);
+        prep_csr(graph, graph.ids.to_current(3), true, after, workspace);
+
+        graph.ids.restore(after.order);
+        std::ranges::sort(before.order);
+        std::ranges::sort(after.order);
+        EXPECT_EQ(before.order, after.order);
+    }
+}
+
+TEST(ModelGenerators, BitIdenticalForAnyThreadCount) {
+    const auto generators = {
+        +[](const int threads) { return create_graph_rmat(4096, 8, seed, threads); },
+        +[](const int threads) { return create_graph_ba(4000, 4, seed, threads); },
+        +[](const int threads) { return create_graph_grid(4000, 3, threads); },
+        +[](const int threads) { return create_graph_geometric(4000, 0.03, seed, threads); },
+    };
+    for (const auto generate : generators) {
+        const Graph expected = generate(1);
+        for (const int threads : {2, 5}) expect_same_csr(expected.csr, generate(threads).csr);
+    }
+}
+
+TEST(CopyOnWrite, ClonesAreIsolated) {
+    Graph original = create_graph(200, 0.05, 0.1, 13);
+    const std::vector<std::vector<int>> before = rows(original);
+    const long long edges = graph_stats(original, 1).edges;
+
+    Graph clone = clone_graph(original);
+    EXPECT_EQ(original.sharers(), 1);
+    EXPECT_EQ(clone.sharers(), 1);
+    EXPECT_EQ(clone.adj_matrix.row(0), original.adj_matrix.row(0));
+
+    const int u = 0;
+    int v = 1;
+    while (original.adj_matrix.test(u, v)) v++;
+    // Some existing non-loop edge a - b
+    int a = 0;
+    while (std::ranges::count_if(before[a], [&](const int w) { return w != a; }) == 0) a++;
+    const int b = *std::ranges::find_if(before[a], [&](const int w) { return w != a; });
+
+    ASSERT_TRUE(add_edge(clone, u, v, 1));
+    ASSERT_TRUE(remove_edge(clone, a, b, 1));
+    add_vertex(clone, 1);
+
+    EXPECT_EQ(original.sharers(), 0);
+    EXPECT_EQ(clone.sharers(), 0);
+    EXPECT_EQ(before, rows(original));
+    EXPECT_EQ(edges, graph_stats(original, 1).edges);
+    EXPECT_FALSE(original.adj_matrix.test(u, v));
+    EXPECT_EQ(clone.n, original.n + 1);
+    EXPECT_EQ(graph_stats(clone, 1).edges, edges);  // One edge added, one removed
+
+    // Updates to the source after cloning do not leak into the clone either
+    Graph second = clone_graph(original);
+    const std::vector<std::vector<int>> clone_rows = rows(second);
+    ASSERT_TRUE(add_edge(original, u, v, 1));
+    EXPECT_EQ(clone_rows, rows(second));
+    EXPECT_FALSE(second.adj_matrix.test(u, v));
+}
+
+TEST(Snapshot, RoundTripKeepsCsrAndMatrix) {
+    const auto path = temp_file("round_trip.bin");
+    Graph graph = create_graph(300, 0.1, 0.2, 3);
+    ensure_csr(graph, 1);
+    save_snapshot(graph, path.string());
+
+    const Graph loaded = load_snapshot(path.string());
+    std::filesystem::remove(path);
+    ASSERT_EQ(loaded.n, graph.n);
+    expect_same_csr(graph.csr, loaded.csr);
+    ASSERT_TRUE(loaded.has_matrix());
+    for (int v = 0; v < graph.n; v++) {
+        EXPECT_EQ(0, std::memcmp(graph.adj_matrix.row(v), loaded.adj_matrix.row(v),
+                                 graph.adj_matrix.row_words() * sizeof(BitMatrix::word_t)));
+    }
+}
+
+TEST(Snapshot, SaveOverTheLoadedFile) {
+    const auto path = temp_file("in_place.bin");
+    Graph graph = create_graph_sparse(2000, 0.005, 0.01, 5);
+    save_snapshot(graph, path.string());
+
+    // The loaded graph is backed by a mapping of path itself
+    const Graph loaded = load_snapshot(path.string());
+    EXPECT_EQ(save_snapshot(loaded, path.string()), std::filesystem::file_size(path));
+    const Graph reloaded = load_snapshot(path.string());
+    std::filesystem::remove(path);
+    expect_same_csr(graph.csr, loaded.csr);
+    expect_same_csr(graph.csr, reloaded.csr);
+}
+
+TEST(Snapshot, RejectsCorruptCsr) {
+    const auto path = temp_file("corrupt.bin");
+    const Graph graph = create_graph_sparse(500, 0.01, 0.01, 9);
+    ASSERT_GT(graph.csr.entries(), 0u);
+
+    save_snapshot(graph, path.string());
+    SnapshotHeader header = read_header(path);
+    patch(path, header.neighbours_pos + 4 * sizeof(int), graph.n + 1000);
+    EXPECT_THROW(load_snapshot(path.string()), std::runtime_error);
+
+    // offsets[0] and offsets[n] stay consistent, offsets[1] runs past offsets[2]
+    save_snapshot(graph, path.string());
+    header = read_header(path);
+    const std::uint64_t past_end = header.entries + 7;
+    if (header.offset_bytes == 4) patch(path, header.offsets_pos + 4, static_cast<std::uint32_t>(past_end));
+    else patch(path, header.offsets_pos + 8, past_end);
+    EXPECT_THROW(load_snapshot(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(Snapshot, RejectsWrappingSectionSizes) {
+    const auto path = temp_file("wrapping.bin");
+    const Graph graph = create_graph_sparse(500, 0.01, 0.01, 9);
+    save_snapshot(graph, path.string());
+    const SnapshotHeader header = read_header(path);
+
+    // entries * sizeof(int) wraps around to the real neighbour section size
+    const std::uint64_t entries = (std::uint64_t{1} << 62) + header.entries;
+    patch(path, offsetof(SnapshotHeader, entries), entries);
+    EXPECT_THROW(load_snapshot(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(Snapshot, RoundTripKeepsOriginalIds) {
+    const auto path = temp_file("reordered.bin");
+    Graph graph = create_graph_sparse(300, 0.02, 0.05, 3);
+    reorder_graph(graph, VertexOrder::Rcm, 1);
+    ASSERT_FALSE(graph.ids.identity());
+    save_snapshot(graph, path.string());
+
+    Graph loaded = load_snapshot(path.string());
+    std::filesystem::remove(path);
+    expect_same_csr(graph.csr, loaded.csr);
+    EXPECT_EQ(graph.ids.original, loaded.ids.original);
+    EXPECT_EQ(graph.ids.current, loaded.ids.current);
+
+    // Same traversal in original ids before and after the round trip
+    Traversal before, after;
+    TraversalWorkspace workspace;
+    prep_csr(graph, graph.ids.to_current(5), false, before, workspace);
+    prep_csr(loaded, loaded.ids.to_current(5), false, after, workspace);
+    graph.ids.restore(before.order);
+    loaded.ids.restore(after.order);
+    EXPECT_EQ(before.order, after.order);
+}
+
+TEST(Snapshot, RejectsIdMapThatIsNotAPermutation) {
+    const auto path = temp_file("bad_ids.bin");
+    Graph graph = create_graph_sparse(100, 0.05, 0.05, 4);
+    reorder_graph(graph, VertexOrder::Degree, 1);
+    save_snapshot(graph, path.string());
+    const SnapshotHeader header = read_header(path);
+    ASSERT_NE(header.flags & snapshot_has_ids, 0u);
+    patch(path, header.ids_pos, graph.ids.original[1]);
+    EXPECT_THROW(load_snapshot(path.string()), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(MultiBfs, MatchesPerSourceReference) {
+    // Several components and isolated vertices, so some lanes never reach most vertices
+    Graph graph = create_graph_parallel(1500, 0.002, 0.05, seed, 1, true);
+    const std::vector<std::vector<int>> adjacency = rows(graph);
+    const std::vector<int> sources = {0, 1, 7, 7, 100, 749, 1499};
+
+    for (const int threads : {1, 4}) {
+        MultiBFSResult result;
+        BFS_multi(sources, graph, result, threads, true);
+        int levels = 0;
+        for (std::size_t i = 0; i < sources.size(); i++) {
+            const std::vector<int> expected = reference_distances(adjacency, sources[i]);
+            const auto begin = result.distance.begin() + static_cast<std::ptrdiff_t>(i * graph.n);
+            EXPECT_EQ(expected, std::vector<int>(begin, begin + graph.n)) << "source " << sources[i];
+
+            long long reached = 0, sum = 0;
+            int eccentricity = 0;
+            for (const int d : expected) {
+                if (d < 0) continue;
+                reached++;
+                sum += d;
+                eccentricity = std::max(eccentricity, d);
+            }
+            EXPECT_EQ(reached, result.reached[i]);
+            EXPECT_EQ(sum, result.distance_sum[i]);
+            EXPECT_EQ(eccentricity, result.eccentricity[i]);
+            levels = std::max(levels, eccentricity);
+        }
+        EXPECT_EQ(levels, result.levels);
+    }
+
+    // Long sweeps on a 200 x 200 grid: 130 neighbouring sources share three lane words for
+    // the whole sweep, the four corners never meet and take the per-source fallback
+    Graph grid = create_graph_grid(40000, 2, 1);
+    const std::vector<std::vector<int>> grid_rows = rows(grid);
+    std::vector<int> neighbouring(130);
+    std::iota(neighbouring.begin(), neighbouring.end(), 0);
+    for (const std::vector<int>& many : {neighbouring, std::vector<int>{0, 199, 39800, 39999}}) {
+        MultiBFSResult result;
+        BFS_multi(many, grid, result, 3, true);
+        for (std::size_t i = 0; i < many.size(); i++) {
+            const std::vector<int> expected = reference_distances(grid_rows, many[i]);
+            const auto begin = result.distance.begin() + static_cast<std::ptrdiff_t>(i * grid.n);
+            EXPECT_EQ(expected, std::vector<int>(begin, begin + grid.n)) << "source " << many[i];
+            EXPECT_EQ(std::ranges::max(expected), result.eccentricity[i]);
+            EXPECT_EQ(grid.n, result.reached[i]);
+        }
+        EXPECT_EQ(398, result.levels);
+    }
+}
+
+TEST(Metrics, TrianglesMatchBruteForce) {
+    // Self-loops must not count, the rmat graph adds skewed degrees for the merge orientation
+    Graph random = create_graph(300, 0.08, 0.3, 17);
+    Graph skewed = create_graph_rmat(512, 12, seed, 1);
+    for (Graph* graph : {&random, &skewed}) {
+        const std::vector<std::vector<int>> adjacency = rows(*graph);
+        const auto adjacent = [&](const int u, const int v) { return std::ranges::binary_search(adjacency[u], v); };
+        long long expected = 0, wedges = 0;
+        for (int u = 0; u < graph->n; u++) {
+            const auto degree = static_cast<long long>(std::ranges::count_if(adjacency[u], [&](const int w) { return w != u; }));
+            wedges += degree * (degree - 1) / 2;
+            for (const int v : adjacency[u]) {
+                if (v <= u) continue;
+                for (const int w : adjacency[v]) {
+                    if (w > v && adjacent(u, w)) expected++;
+                }
+            }
+        }
+        ASSERT_GT(expected, 0);
+
+        for (const TriangleMethod method : {TriangleMethod::Bitset, TriangleMethod::Merge}) {
+            for (const int threads : {1, 4}) {
+                const GraphMetrics metrics = graph_metrics(*graph, threads, method);
+                EXPECT_EQ(expected, metrics.triangles);
+                EXPECT_EQ(wedges, metrics.wedges);
+                EXPECT_EQ(method == TriangleMethod::Bitset, metrics.bitset);
+            }
+        }
+    }
+}